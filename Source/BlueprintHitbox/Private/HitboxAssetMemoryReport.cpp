@@ -0,0 +1,75 @@
+#include "HitboxDataAsset.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+/**
+ * Lists every loaded hitbox asset, largest first, with the memory of each animation and the totals.
+ * Numbers come from UHitboxDataAsset::GetMemoryUsage, the same as GetResourceSizeEx and memreport.
+ */
+static FAutoConsoleCommandWithArgs HitboxListAssetsCommand(
+	TEXT("hitbox.ListAssets"),
+	TEXT("List loaded hitbox assets sorted by memory, with a per-animation breakdown. Usage: hitbox.ListAssets [-NoAnims]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const bool bShowAnimations = !Args.Contains(TEXT("-NoAnims"));
+
+		struct FAssetEntry
+		{
+			const UHitboxDataAsset* Asset;
+			FHitboxAssetMemory Memory;
+		};
+
+		TArray<FAssetEntry> Entries;
+		for (TObjectIterator<UHitboxDataAsset> It; It; ++It)
+		{
+			if (It->HasAnyFlags(RF_ClassDefaultObject)) continue;
+			Entries.Add({ *It, It->GetMemoryUsage() });
+		}
+		Entries.Sort([](const FAssetEntry& A, const FAssetEntry& B) { return A.Memory.GetTotal() > B.Memory.GetTotal(); });
+
+		auto LogMemory = [](const TCHAR* Indent, const FString& Label, const FHitboxAssetMemory& Memory)
+		{
+			UE_LOG(LogTemp, Log, TEXT("%s%-40s %9.2f KB  (boxes %lld, sockets %lld, names %lld, lookup %lld, containers %lld, editor %lld, object %lld)"),
+				Indent, *Label, Memory.GetTotal() / 1024.0,
+				Memory.Boxes, Memory.Sockets, Memory.Names, Memory.LookupTables, Memory.Containers, Memory.EditorData, Memory.Object);
+		};
+
+		FHitboxAssetMemory Total;
+		int32 TotalAnimations = 0;
+		int32 TotalFrames = 0;
+		int32 TotalBoxes = 0;
+		int32 TotalSockets = 0;
+
+		UE_LOG(LogTemp, Log, TEXT("hitbox.ListAssets: %d loaded hitbox assets"), Entries.Num());
+		for (const FAssetEntry& Entry : Entries)
+		{
+			LogMemory(TEXT(""), Entry.Asset->GetPathName(), Entry.Memory);
+			Total += Entry.Memory;
+
+			for (const FAnimationHitboxData& Anim : Entry.Asset->Animations)
+			{
+				int32 NumBoxes = 0;
+				int32 NumSockets = 0;
+				for (const FFrameHitboxData& Frame : Anim.Frames)
+				{
+					NumBoxes += Frame.Hitboxes.Num();
+					NumSockets += Frame.Sockets.Num();
+				}
+
+				TotalAnimations++;
+				TotalFrames += Anim.Frames.Num();
+				TotalBoxes += NumBoxes;
+				TotalSockets += NumSockets;
+
+				if (bShowAnimations)
+				{
+					LogMemory(TEXT("    "), FString::Printf(TEXT("%s [%d frames, %d boxes, %d sockets]"), *Anim.AnimationName, Anim.Frames.Num(), NumBoxes, NumSockets), Anim.GetMemoryUsage());
+				}
+			}
+		}
+
+		LogMemory(TEXT(""), TEXT("Total"), Total);
+		UE_LOG(LogTemp, Log, TEXT("hitbox.ListAssets: %d animations, %d frames, %d boxes, %d sockets"),
+			TotalAnimations, TotalFrames, TotalBoxes, TotalSockets);
+	})
+);
@@ -1,4 +1,6 @@
 #include "HitboxBlueprintLibrary.h"
+#include "HitboxWorldCache.h"
+#include "HitboxStats.h"
 
 // ==========================================
 // WORLD SPACE CONVERSION
@@ -57,6 +59,27 @@ bool UHitboxBlueprintLibrary::DoBoxesOverlap(const FBox2D& BoxA, const FBox2D& B
 	return BoxA.Intersect(BoxB);
 }
 
+FVector2D UHitboxBlueprintLibrary::GetBoxSeparation(const FBox2D& BoxA, const FBox2D& BoxB)
+{
+	const double PenetrationX = FMath::Min(BoxA.Max.X, BoxB.Max.X) - FMath::Max(BoxA.Min.X, BoxB.Min.X);
+	const double PenetrationY = FMath::Min(BoxA.Max.Y, BoxB.Max.Y) - FMath::Max(BoxA.Min.Y, BoxB.Min.Y);
+
+	// Touching edges need no correction
+	if (PenetrationX <= 0.0 || PenetrationY <= 0.0)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	if (PenetrationX <= PenetrationY)
+	{
+		const double Sign = BoxA.GetCenter().X < BoxB.GetCenter().X ? -1.0 : 1.0;
+		return FVector2D(Sign * PenetrationX, 0.0);
+	}
+
+	const double Sign = BoxA.GetCenter().Y < BoxB.GetCenter().Y ? -1.0 : 1.0;
+	return FVector2D(0.0, Sign * PenetrationY);
+}
+
 bool UHitboxBlueprintLibrary::CheckHitboxCollision(
 	const FFrameHitboxData& AttackerFrame,
 	FVector2D AttackerPosition,
@@ -68,6 +91,8 @@ bool UHitboxBlueprintLibrary::CheckHitboxCollision(
 	float DefenderScale,
 	TArray<FHitboxCollisionResult>& OutResults)
 {
+	SCOPE_CYCLE_COUNTER(STAT_HitboxNarrowphase);
+
 	OutResults.Empty();
 
 	// Get attack hitboxes from attacker
@@ -76,8 +101,13 @@ bool UHitboxBlueprintLibrary::CheckHitboxCollision(
 
 	// Get hurtboxes from defender
 	TArray<FHitboxData> HurtBoxes = DefenderFrame.GetHitboxesByType(EHitboxType::Hurtbox);
+	INC_DWORD_STAT_BY(STAT_HitboxTempAllocations, HurtBoxes.Num() > 0 ? 2 : 1);
 	if (HurtBoxes.Num() == 0) return false;
 
+	// Hurtboxes are transformed again for every attack box
+	INC_DWORD_STAT_BY(STAT_HitboxPairsTested, AttackBoxes.Num() * HurtBoxes.Num());
+	INC_DWORD_STAT_BY(STAT_HitboxBoxesTransformed, AttackBoxes.Num() * (1 + HurtBoxes.Num()));
+
 	bool bAnyHit = false;
 
 	// Check each attack box against each hurtbox
@@ -91,29 +121,108 @@ bool UHitboxBlueprintLibrary::CheckHitboxCollision(
 
 			if (AttackWorld.Intersect(HurtWorld))
 			{
-				FHitboxCollisionResult Result;
-				Result.bHit = true;
-				Result.AttackHitbox = Attack;
-				Result.HurtHitbox = Hurt;
-				Result.Damage = Attack.Damage;
-				Result.Knockback = Attack.Knockback;
-
-				// Calculate hit location (center of overlap)
-				FBox2D Overlap(
-					FVector2D(FMath::Max(AttackWorld.Min.X, HurtWorld.Min.X), FMath::Max(AttackWorld.Min.Y, HurtWorld.Min.Y)),
-					FVector2D(FMath::Min(AttackWorld.Max.X, HurtWorld.Max.X), FMath::Min(AttackWorld.Max.Y, HurtWorld.Max.Y))
-				);
-				Result.HitLocation = Overlap.GetCenter();
-
-				OutResults.Add(Result);
+				OutResults.Add(MakeCollisionResult(Attack, AttackWorld, Hurt, HurtWorld));
 				bAnyHit = true;
 			}
 		}
 	}
 
+	INC_DWORD_STAT_BY(STAT_HitboxHits, OutResults.Num());
+	INC_DWORD_STAT_BY(STAT_HitboxTempAllocations, bAnyHit ? 1 : 0);
 	return bAnyHit;
 }
 
+FHitboxCollisionResult UHitboxBlueprintLibrary::MakeCollisionResult(const FHitboxData& Attack, const FBox2D& AttackWorld, const FHitboxData& Hurt, const FBox2D& HurtWorld)
+{
+	FHitboxCollisionResult Result;
+	Result.bHit = true;
+	Result.AttackHitbox = Attack;
+	Result.HurtHitbox = Hurt;
+	Result.Damage = Attack.Damage;
+	Result.Knockback = Attack.Knockback;
+
+	// Calculate hit location (center of overlap)
+	FBox2D Overlap(
+		FVector2D(FMath::Max(AttackWorld.Min.X, HurtWorld.Min.X), FMath::Max(AttackWorld.Min.Y, HurtWorld.Min.Y)),
+		FVector2D(FMath::Min(AttackWorld.Max.X, HurtWorld.Max.X), FMath::Min(AttackWorld.Max.Y, HurtWorld.Max.Y))
+	);
+	Result.HitLocation = Overlap.GetCenter();
+
+	return Result;
+}
+
+bool UHitboxBlueprintLibrary::CheckCachedCollision(const FHitboxWorldCache& Attacker, const FHitboxWorldCache& Defender, TArray<FHitboxCollisionResult>& OutResults)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxNarrowphase);
+
+	OutResults.Reset();
+
+	// Bounds reject whole frames before any box pair is visited
+	if (!Attacker.Frame || !Defender.Frame) return false;
+	if (!Attacker.AttackBounds.bIsValid || !Defender.HurtBounds.bIsValid) return false;
+	if (!Attacker.AttackBounds.Intersect(Defender.HurtBounds)) return false;
+
+	const TArray<FHitboxData>& AttackBoxes = Attacker.Frame->Hitboxes;
+	const TArray<FHitboxData>& HurtBoxes = Defender.Frame->Hitboxes;
+	int32 PairsTested = 0;
+
+	for (int32 AttackIndex = 0; AttackIndex < AttackBoxes.Num(); ++AttackIndex)
+	{
+		if (AttackBoxes[AttackIndex].Type != EHitboxType::Attack) continue;
+
+		const FBox2D& AttackWorld = Attacker.Boxes[AttackIndex];
+		if (!AttackWorld.Intersect(Defender.HurtBounds)) continue;
+
+		for (int32 HurtIndex = 0; HurtIndex < HurtBoxes.Num(); ++HurtIndex)
+		{
+			if (HurtBoxes[HurtIndex].Type != EHitboxType::Hurtbox) continue;
+
+			++PairsTested;
+			const FBox2D& HurtWorld = Defender.Boxes[HurtIndex];
+			if (AttackWorld.Intersect(HurtWorld))
+			{
+				OutResults.Add(MakeCollisionResult(AttackBoxes[AttackIndex], AttackWorld, HurtBoxes[HurtIndex], HurtWorld));
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_HitboxPairsTested, PairsTested);
+	INC_DWORD_STAT_BY(STAT_HitboxHits, OutResults.Num());
+	return OutResults.Num() > 0;
+}
+
+bool UHitboxBlueprintLibrary::QuickCachedHitCheck(const FHitboxWorldCache& Attacker, const FHitboxWorldCache& Defender)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxNarrowphase);
+
+	if (!Attacker.Frame || !Defender.Frame) return false;
+	if (!Attacker.AttackBounds.bIsValid || !Defender.HurtBounds.bIsValid) return false;
+	if (!Attacker.AttackBounds.Intersect(Defender.HurtBounds)) return false;
+
+	const TArray<FHitboxData>& AttackBoxes = Attacker.Frame->Hitboxes;
+	const TArray<FHitboxData>& HurtBoxes = Defender.Frame->Hitboxes;
+
+	for (int32 AttackIndex = 0; AttackIndex < AttackBoxes.Num(); ++AttackIndex)
+	{
+		if (AttackBoxes[AttackIndex].Type != EHitboxType::Attack) continue;
+
+		const FBox2D& AttackWorld = Attacker.Boxes[AttackIndex];
+		for (int32 HurtIndex = 0; HurtIndex < HurtBoxes.Num(); ++HurtIndex)
+		{
+			if (HurtBoxes[HurtIndex].Type != EHitboxType::Hurtbox) continue;
+
+			INC_DWORD_STAT(STAT_HitboxPairsTested);
+			if (AttackWorld.Intersect(Defender.Boxes[HurtIndex]))
+			{
+				INC_DWORD_STAT(STAT_HitboxHits);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 bool UHitboxBlueprintLibrary::CheckHitboxCollision3D(
 	const FFrameHitboxData& AttackerFrame,
 	FVector AttackerPosition,
@@ -148,12 +257,16 @@ bool UHitboxBlueprintLibrary::QuickHitCheck(
 	bool bDefenderFlipX,
 	float DefenderScale)
 {
+	SCOPE_CYCLE_COUNTER(STAT_HitboxNarrowphase);
+
 	TArray<FHitboxData> AttackBoxes = AttackerFrame.GetHitboxesByType(EHitboxType::Attack);
 	if (AttackBoxes.Num() == 0) return false;
 
 	TArray<FHitboxData> HurtBoxes = DefenderFrame.GetHitboxesByType(EHitboxType::Hurtbox);
+	INC_DWORD_STAT_BY(STAT_HitboxTempAllocations, HurtBoxes.Num() > 0 ? 2 : 1);
 	if (HurtBoxes.Num() == 0) return false;
 
+	int32 PairsTested = 0;
 	for (const FHitboxData& Attack : AttackBoxes)
 	{
 		FBox2D AttackWorld = HitboxToWorldSpace(Attack, AttackerPosition, bAttackerFlipX, AttackerScale);
@@ -162,32 +275,164 @@ bool UHitboxBlueprintLibrary::QuickHitCheck(
 		{
 			FBox2D HurtWorld = HitboxToWorldSpace(Hurt, DefenderPosition, bDefenderFlipX, DefenderScale);
 
+			++PairsTested;
 			if (AttackWorld.Intersect(HurtWorld))
 			{
+				INC_DWORD_STAT_BY(STAT_HitboxPairsTested, PairsTested);
+				INC_DWORD_STAT_BY(STAT_HitboxBoxesTransformed, PairsTested + FMath::DivideAndRoundUp(PairsTested, HurtBoxes.Num()));
+				INC_DWORD_STAT(STAT_HitboxHits);
 				return true;
 			}
 		}
 	}
 
+	INC_DWORD_STAT_BY(STAT_HitboxPairsTested, PairsTested);
+	INC_DWORD_STAT_BY(STAT_HitboxBoxesTransformed, PairsTested + AttackBoxes.Num());
 	return false;
 }
 
+// ==========================================
+// RAYCASTS
+// ==========================================
+
+bool UHitboxBlueprintLibrary::RaycastFrameHitboxes(
+	const FFrameHitboxData& FrameData,
+	FVector2D WorldPosition,
+	bool bFlipX,
+	float Scale,
+	FVector2D Start,
+	FVector2D End,
+	EHitboxType Type,
+	FHitboxRaycastResult& OutHit)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::RaycastFrameHitboxes);
+
+	OutHit = FHitboxRaycastResult();
+
+	// Transform all candidate boxes first so the slab test runs over one contiguous array
+	TArray<FBox2D, TInlineAllocator<16>> WorldBoxes;
+	TArray<int32, TInlineAllocator<16>> HitboxIndices;
+	for (int32 Index = 0; Index < FrameData.Hitboxes.Num(); ++Index)
+	{
+		const FHitboxData& Hitbox = FrameData.Hitboxes[Index];
+		if (Hitbox.Type != Type) continue;
+
+		WorldBoxes.Add(HitboxToWorldSpace(Hitbox, WorldPosition, bFlipX, Scale));
+		HitboxIndices.Add(Index);
+	}
+	INC_DWORD_STAT_BY(STAT_HitboxBoxesTransformed, WorldBoxes.Num());
+
+	float Time = 1.0f;
+	FVector2D Normal = FVector2D::ZeroVector;
+	const int32 BoxIndex = RaycastBoxes(WorldBoxes, Start, End, Time, Normal);
+	if (BoxIndex == INDEX_NONE) return false;
+
+	OutHit.bHit = true;
+	OutHit.Hitbox = FrameData.Hitboxes[HitboxIndices[BoxIndex]];
+	OutHit.Time = Time;
+	OutHit.Location = Start + (End - Start) * Time;
+	OutHit.Normal = Normal;
+	OutHit.Distance = (End - Start).Size() * Time;
+	return true;
+}
+
+int32 UHitboxBlueprintLibrary::RaycastBoxes(TConstArrayView<FBox2D> Boxes, const FVector2D& Start, const FVector2D& End, float& OutTime, FVector2D& OutNormal)
+{
+	const FVector2D Dir = End - Start;
+
+	// Axes the segment is parallel to can't be entered; they only reject boxes it runs outside of
+	const bool bParallelX = FMath::IsNearlyZero(Dir.X);
+	const bool bParallelY = FMath::IsNearlyZero(Dir.Y);
+	const double InvDirX = bParallelX ? 0.0 : 1.0 / Dir.X;
+	const double InvDirY = bParallelY ? 0.0 : 1.0 / Dir.Y;
+
+	int32 BestIndex = INDEX_NONE;
+	double BestTime = TNumericLimits<double>::Max();
+	bool bBestEnteredX = false;
+
+	for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+	{
+		const FBox2D& Box = Boxes[Index];
+
+		double EnterX = -TNumericLimits<double>::Max();
+		double ExitX = TNumericLimits<double>::Max();
+		if (bParallelX)
+		{
+			if (Start.X < Box.Min.X || Start.X > Box.Max.X) continue;
+		}
+		else
+		{
+			const double T0 = (Box.Min.X - Start.X) * InvDirX;
+			const double T1 = (Box.Max.X - Start.X) * InvDirX;
+			EnterX = FMath::Min(T0, T1);
+			ExitX = FMath::Max(T0, T1);
+		}
+
+		double EnterY = -TNumericLimits<double>::Max();
+		double ExitY = TNumericLimits<double>::Max();
+		if (bParallelY)
+		{
+			if (Start.Y < Box.Min.Y || Start.Y > Box.Max.Y) continue;
+		}
+		else
+		{
+			const double T0 = (Box.Min.Y - Start.Y) * InvDirY;
+			const double T1 = (Box.Max.Y - Start.Y) * InvDirY;
+			EnterY = FMath::Min(T0, T1);
+			ExitY = FMath::Max(T0, T1);
+		}
+
+		const double Enter = FMath::Max(EnterX, EnterY);
+		const double Exit = FMath::Min(ExitX, ExitY);
+		if (Enter > Exit || Exit < 0.0 || Enter > 1.0) continue;
+
+		// Segment starting inside a box hits it at the start
+		const double HitTime = FMath::Max(Enter, 0.0);
+		if (HitTime < BestTime)
+		{
+			BestTime = HitTime;
+			BestIndex = Index;
+			bBestEnteredX = Enter > 0.0 && EnterX >= EnterY;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE) return INDEX_NONE;
+
+	OutTime = (float)BestTime;
+	if (BestTime <= 0.0)
+	{
+		OutNormal = -Dir.GetSafeNormal();
+	}
+	else if (bBestEnteredX)
+	{
+		OutNormal = FVector2D(Dir.X > 0.0 ? -1.0 : 1.0, 0.0);
+	}
+	else
+	{
+		OutNormal = FVector2D(0.0, Dir.Y > 0.0 ? -1.0 : 1.0);
+	}
+	return BestIndex;
+}
+
 // ==========================================
 // FRAME DATA HELPERS
 // ==========================================
 
 TArray<FHitboxData> UHitboxBlueprintLibrary::GetAttackHitboxes(const FFrameHitboxData& FrameData)
 {
+	INC_DWORD_STAT(STAT_HitboxTempAllocations);
 	return FrameData.GetHitboxesByType(EHitboxType::Attack);
 }
 
 TArray<FHitboxData> UHitboxBlueprintLibrary::GetHurtboxes(const FFrameHitboxData& FrameData)
 {
+	INC_DWORD_STAT(STAT_HitboxTempAllocations);
 	return FrameData.GetHitboxesByType(EHitboxType::Hurtbox);
 }
 
 TArray<FHitboxData> UHitboxBlueprintLibrary::GetCollisionBoxes(const FFrameHitboxData& FrameData)
 {
+	INC_DWORD_STAT(STAT_HitboxTempAllocations);
 	return FrameData.GetHitboxesByType(EHitboxType::Collision);
 }
 
@@ -225,6 +470,21 @@ FString UHitboxBlueprintLibrary::HitboxTypeToString(EHitboxType Type)
 	}
 }
 
+FLinearColor UHitboxBlueprintLibrary::GetHitboxTypeColor(EHitboxType Type)
+{
+	switch (Type)
+	{
+	case EHitboxType::Attack:
+		return FLinearColor::Red;
+	case EHitboxType::Hurtbox:
+		return FLinearColor::Green;
+	case EHitboxType::Collision:
+		return FLinearColor::Blue;
+	default:
+		return FLinearColor::White;
+	}
+}
+
 EHitboxType UHitboxBlueprintLibrary::StringToHitboxType(const FString& TypeString)
 {
 	if (TypeString.Equals(TEXT("hurtbox"), ESearchCase::IgnoreCase))
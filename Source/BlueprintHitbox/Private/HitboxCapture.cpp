@@ -0,0 +1,319 @@
+#include "HitboxCapture.h"
+#include "HitboxParticipant.h"
+#include "HitboxStats.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+// ==========================================
+// RECORDS
+// ==========================================
+
+void HitboxCapture::SerializeRecord(FArchive& Ar, FHitboxCaptureRecord& Record)
+{
+	uint32 Id = (uint32)Record.Id;
+	Ar.SerializeIntPacked(Id);
+	Record.Id = (int32)Id;
+
+	// Flags first so the reader knows whether registration fields follow
+	uint8 Flags = (Record.bFlipX ? 1 : 0) | (Record.bRegistered ? 2 : 0) | ((uint8)Record.Tier << 2);
+	Ar << Flags;
+	Record.bFlipX = (Flags & 1) != 0;
+	Record.bRegistered = (Flags & 2) != 0;
+	Record.Tier = (EHitboxProcessingTier)((Flags >> 2) & 3);
+
+	// Shifted by one so "no frame" packs into a single byte
+	uint32 Animation = (uint32)(Record.AnimationIndex + 1);
+	uint32 Frame = (uint32)(Record.FrameIndex + 1);
+	Ar.SerializeIntPacked(Animation);
+	Ar.SerializeIntPacked(Frame);
+	Record.AnimationIndex = (int32)Animation - 1;
+	Record.FrameIndex = (int32)Frame - 1;
+
+	uint32 TierPhase = (uint32)Record.TierPhase;
+	Ar.SerializeIntPacked(TierPhase);
+	Record.TierPhase = (int32)TierPhase;
+
+	Ar << Record.Position.X;
+	Ar << Record.Position.Y;
+	Ar << Record.Scale;
+
+	if (Record.bRegistered)
+	{
+		uint32 Owner = (uint32)Record.OwnerIndex;
+		uint32 Asset = (uint32)Record.AssetIndex;
+		Ar.SerializeIntPacked(Owner);
+		Ar.SerializeIntPacked(Asset);
+		Record.OwnerIndex = (int32)Owner;
+		Record.AssetIndex = (int32)Asset;
+
+		Ar << Record.Team;
+		Ar << Record.RehitInterval;
+	}
+}
+
+// ==========================================
+// WRITER
+// ==========================================
+
+FHitboxCaptureWriter::~FHitboxCaptureWriter()
+{
+	Close();
+}
+
+bool FHitboxCaptureWriter::Open(const FString& InFilename, EHitboxHitDispatch HitDispatch, bool bTrackAttackInstances, int32 InReducedUpdateInterval)
+{
+	Close();
+
+	Archive.Reset(IFileManager::Get().CreateFileWriter(*InFilename));
+	if (!Archive) return false;
+
+	Filename = InFilename;
+	NumTicks = 0;
+	ReducedUpdateInterval = FMath::Max(InReducedUpdateInterval, 1);
+	Captured.Reset();
+	OwnerIndices.Reset();
+	WrittenAssets.Reset();
+
+	uint32 Magic = HitboxCapture::Magic;
+	uint32 Version = HitboxCapture::Version;
+	uint8 Dispatch = (uint8)HitDispatch;
+	uint8 TrackAttackInstances = bTrackAttackInstances ? 1 : 0;
+	*Archive << Magic;
+	*Archive << Version;
+	*Archive << Dispatch;
+	*Archive << TrackAttackInstances;
+	*Archive << ReducedUpdateInterval;
+	return true;
+}
+
+void FHitboxCaptureWriter::WriteTick(float DeltaTime, uint32 TickCounter, TConstArrayView<FHitboxParticipant> Participants)
+{
+	if (!Archive) return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::WriteCaptureTick);
+
+	const uint32 Tick = (uint32)++NumTicks;
+	Removed.Reset();
+	Changed.Reset();
+
+	// Phases are made relative to the capture's first tick, so a replay starting at any tick counter throttles the same ticks
+	const uint32 FirstTickCounter = TickCounter - Tick;
+
+	for (const FHitboxParticipant& Participant : Participants)
+	{
+		FHitboxCaptureRecord Record;
+		Record.Id = Participant.Id;
+		Record.AnimationIndex = Participant.AnimationIndex;
+		Record.FrameIndex = Participant.FrameIndex;
+		Record.Position = FVector2f(Participant.Position);
+		Record.Scale = Participant.Scale;
+		Record.Tier = Participant.Tier;
+		Record.bFlipX = Participant.bFlipX;
+		Record.TierPhase = (int32)((FirstTickCounter + (uint32)Participant.TierPhase) % (uint32)ReducedUpdateInterval);
+		Record.OwnerIndex = OwnerIndices.FindOrAdd(Participant.Owner, OwnerIndices.Num());
+		Record.AssetIndex = Participant.AssetIndex;
+		Record.Team = Participant.Team;
+		Record.RehitInterval = Participant.RehitInterval;
+
+		// Asset blocks go ahead of the tick block that first refers to them
+		if (Participant.AssetIndex != INDEX_NONE && !WrittenAssets.Contains(Participant.AssetIndex))
+		{
+			WrittenAssets.Add(Participant.AssetIndex);
+
+			uint8 Block = (uint8)HitboxCapture::EBlock::Asset;
+			uint32 AssetIndex = (uint32)Participant.AssetIndex;
+			FString Path = Participant.Asset ? Participant.Asset->GetPathName() : FString();
+			*Archive << Block;
+			Archive->SerializeIntPacked(AssetIndex);
+			*Archive << Path;
+		}
+
+		FCapturedState* State = Captured.Find(Record.Id);
+		if (!State)
+		{
+			Record.bRegistered = true;
+			Captured.Add(Record.Id, { Record, Tick });
+			Changed.Add(Record);
+			continue;
+		}
+
+		State->LastSeenTick = Tick;
+		const FHitboxCaptureRecord& Last = State->Record;
+
+		// Registration settings changing means the id was reused (rollback) and has to be registered again
+		Record.bRegistered = Record.OwnerIndex != Last.OwnerIndex
+			|| Record.AssetIndex != Last.AssetIndex
+			|| Record.Team != Last.Team
+			|| Record.RehitInterval != Last.RehitInterval;
+
+		if (Record.bRegistered
+			|| Record.AnimationIndex != Last.AnimationIndex
+			|| Record.FrameIndex != Last.FrameIndex
+			|| Record.Position != Last.Position
+			|| Record.Scale != Last.Scale
+			|| Record.Tier != Last.Tier
+			|| Record.TierPhase != Last.TierPhase
+			|| Record.bFlipX != Last.bFlipX)
+		{
+			State->Record = Record;
+			Changed.Add(Record);
+		}
+	}
+
+	for (auto It = Captured.CreateIterator(); It; ++It)
+	{
+		if (It->Value.LastSeenTick != Tick)
+		{
+			Removed.Add(It->Key);
+			It.RemoveCurrent();
+		}
+	}
+
+	uint8 Block = (uint8)HitboxCapture::EBlock::Tick;
+	uint32 NumRemoved = (uint32)Removed.Num();
+	uint32 NumChanged = (uint32)Changed.Num();
+	*Archive << Block;
+	*Archive << DeltaTime;
+	Archive->SerializeIntPacked(NumRemoved);
+	for (int32 Id : Removed)
+	{
+		uint32 PackedId = (uint32)Id;
+		Archive->SerializeIntPacked(PackedId);
+	}
+	Archive->SerializeIntPacked(NumChanged);
+	for (FHitboxCaptureRecord& Record : Changed)
+	{
+		HitboxCapture::SerializeRecord(*Archive, Record);
+	}
+}
+
+void FHitboxCaptureWriter::Close()
+{
+	if (!Archive) return;
+
+	uint8 Block = (uint8)HitboxCapture::EBlock::End;
+	*Archive << Block;
+	Archive->Close();
+	Archive.Reset();
+}
+
+int64 FHitboxCaptureWriter::GetNumBytes() const
+{
+	return Archive ? Archive->Tell() : 0;
+}
+
+// ==========================================
+// READER
+// ==========================================
+
+bool FHitboxCapture::Load(const FString& Filename)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::LoadCapture);
+
+	AssetPaths.Reset();
+	Ticks.Reset();
+	NumOwners = 0;
+
+	TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Archive) return false;
+	FArchive& Ar = *Archive;
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint8 Dispatch = 0;
+	uint8 TrackAttackInstances = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsError() || Magic != HitboxCapture::Magic || Version != HitboxCapture::Version) return false;
+
+	Ar << Dispatch;
+	Ar << TrackAttackInstances;
+	Ar << ReducedUpdateInterval;
+	HitDispatch = (EHitboxHitDispatch)Dispatch;
+	bTrackAttackInstances = TrackAttackInstances != 0;
+
+	// Counts can't exceed the bytes left; guards against reading garbage as a huge allocation
+	const int64 TotalSize = Ar.TotalSize();
+	bool bReadingTick = false;
+
+	while (!Ar.AtEnd() && !Ar.IsError())
+	{
+		uint8 Block = 0;
+		Ar << Block;
+
+		switch ((HitboxCapture::EBlock)Block)
+		{
+		case HitboxCapture::EBlock::End:
+			return !Ar.IsError();
+
+		case HitboxCapture::EBlock::Asset:
+		{
+			uint32 AssetIndex = 0;
+			FString Path;
+			Ar.SerializeIntPacked(AssetIndex);
+			Ar << Path;
+			if (Ar.IsError()) break;
+			if (AssetIndex > MAX_uint16) return false;
+
+			if (AssetPaths.Num() <= (int32)AssetIndex)
+			{
+				AssetPaths.SetNum(AssetIndex + 1);
+			}
+			AssetPaths[AssetIndex] = MoveTemp(Path);
+			break;
+		}
+
+		case HitboxCapture::EBlock::Tick:
+		{
+			bReadingTick = true;
+			FHitboxCaptureTick& Tick = Ticks.AddDefaulted_GetRef();
+			Ar << Tick.DeltaTime;
+
+			uint32 NumRemoved = 0;
+			Ar.SerializeIntPacked(NumRemoved);
+			if (NumRemoved > TotalSize)
+			{
+				Ar.SetError();
+				break;
+			}
+			Tick.Removed.SetNumUninitialized(NumRemoved);
+			for (int32& Id : Tick.Removed)
+			{
+				uint32 PackedId = 0;
+				Ar.SerializeIntPacked(PackedId);
+				Id = (int32)PackedId;
+			}
+
+			uint32 NumChanged = 0;
+			Ar.SerializeIntPacked(NumChanged);
+			if (NumChanged > TotalSize)
+			{
+				Ar.SetError();
+				break;
+			}
+			Tick.Changed.SetNum(NumChanged);
+			for (FHitboxCaptureRecord& Record : Tick.Changed)
+			{
+				HitboxCapture::SerializeRecord(Ar, Record);
+				if (Record.bRegistered && !Ar.IsError())
+				{
+					NumOwners = FMath::Max(NumOwners, Record.OwnerIndex + 1);
+				}
+			}
+			bReadingTick = Ar.IsError();
+			break;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	// No end block: the session ended without closing the capture, keep the ticks that were written in full
+	if (bReadingTick)
+	{
+		Ticks.Pop();
+	}
+	UE_LOG(LogTemp, Warning, TEXT("HitboxCapture: '%s' was not closed, loaded %d complete ticks"), *Filename, Ticks.Num());
+	return Ticks.Num() > 0;
+}
@@ -0,0 +1,328 @@
+#include "HitboxComponent.h"
+#include "HitboxBlueprintLibrary.h"
+#include "HitboxWorldSubsystem.h"
+#include "HitboxStats.h"
+#include "PaperFlipbookComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+UHitboxComponent::UHitboxComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+// ==========================================
+// LIFECYCLE
+// ==========================================
+
+void UHitboxComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Bind here even if a flipbook was assigned earlier, the update mode is final by now
+	UPaperFlipbookComponent* Target = FlipbookComponent;
+	if (!Target)
+	{
+		if (AActor* Owner = GetOwner())
+		{
+			Target = Owner->FindComponentByClass<UPaperFlipbookComponent>();
+		}
+	}
+	SetFlipbookComponent(Target);
+
+	if (bRegisterWithWorld && HitboxData)
+	{
+		if (UHitboxWorldSubsystem* Subsystem = GetHitboxSubsystem())
+		{
+			ParticipantId = Subsystem->RegisterParticipant(GetOwner(), HitboxData, Team);
+			Subsystem->SetParticipantRehitInterval(ParticipantId, RehitInterval);
+		}
+	}
+
+	RefreshFrame();
+
+	if (bBatchedUpdates)
+	{
+		if (UHitboxWorldSubsystem* Subsystem = GetHitboxSubsystem())
+		{
+			Subsystem->AddManagedComponent(this);
+			SetComponentTickEnabled(false);
+		}
+	}
+}
+
+void UHitboxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ManagedIndex != INDEX_NONE)
+	{
+		if (UHitboxWorldSubsystem* Subsystem = GetHitboxSubsystem())
+		{
+			Subsystem->RemoveManagedComponent(this);
+		}
+	}
+
+	if (FlipbookComponent)
+	{
+		FlipbookComponent->TransformUpdated.Remove(TransformUpdatedHandle);
+		TransformUpdatedHandle.Reset();
+	}
+
+	if (ParticipantId != INDEX_NONE)
+	{
+		if (UHitboxWorldSubsystem* Subsystem = GetHitboxSubsystem())
+		{
+			Subsystem->UnregisterParticipant(ParticipantId);
+		}
+		ParticipantId = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UHitboxComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	RefreshFrame();
+}
+
+// ==========================================
+// BINDING
+// ==========================================
+
+void UHitboxComponent::SetFlipbookComponent(UPaperFlipbookComponent* InFlipbookComponent)
+{
+	if (FlipbookComponent)
+	{
+		PrimaryComponentTick.RemovePrerequisite(FlipbookComponent, FlipbookComponent->PrimaryComponentTick);
+		FlipbookComponent->TransformUpdated.Remove(TransformUpdatedHandle);
+		TransformUpdatedHandle.Reset();
+	}
+
+	FlipbookComponent = InFlipbookComponent;
+	FlipbookState.Flipbook = nullptr;
+
+	// Read the flipbook only after it has advanced this frame
+	if (FlipbookComponent)
+	{
+		PrimaryComponentTick.AddPrerequisite(FlipbookComponent, FlipbookComponent->PrimaryComponentTick);
+
+		// Movement can't be scheduled like frame changes, so listen for it
+		if (bEventDrivenUpdates && !bBatchedUpdates)
+		{
+			TransformUpdatedHandle = FlipbookComponent->TransformUpdated.AddUObject(this, &UHitboxComponent::OnFlipbookTransformUpdated);
+		}
+	}
+}
+
+void UHitboxComponent::RefreshFrame()
+{
+	bool bFrameChanged = false;
+	const bool bChanged = UpdateFromFlipbook(bFrameChanged);
+
+	ScheduleNextRefresh();
+
+	if (bChanged && ParticipantId != INDEX_NONE)
+	{
+		if (UHitboxWorldSubsystem* Subsystem = GetHitboxSubsystem())
+		{
+			Subsystem->SetParticipantFrame(ParticipantId, FlipbookState.AnimationIndex, FlipbookState.FrameIndex);
+			Subsystem->SetParticipantTransform(ParticipantId, FlipbookState.Position, FlipbookState.bFlipX, FlipbookState.Scale);
+		}
+	}
+
+	if (bFrameChanged)
+	{
+		OnHitboxFrameChanged.Broadcast(this, FlipbookState.AnimationIndex, FlipbookState.FrameIndex);
+	}
+}
+
+void UHitboxComponent::OnFlipbookTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	RefreshFrame();
+}
+
+bool FHitboxFlipbookState::Update(const UPaperFlipbookComponent& FlipbookComponent, const UHitboxDataAsset& Data, bool bAutoFlipX, bool bManualFlipX, bool& bOutFrameChanged)
+{
+	const int32 PrevAnimationIndex = AnimationIndex;
+	const int32 PrevFrameIndex = FrameIndex;
+	const FVector2D PrevPosition = Position;
+	const bool bPrevFlipX = bFlipX;
+	const float PrevScale = Scale;
+
+	// Resolve the animation only when a different Flipbook starts playing
+	UPaperFlipbook* CurrentFlipbook = FlipbookComponent.GetFlipbook();
+	if (Flipbook != CurrentFlipbook)
+	{
+		Flipbook = CurrentFlipbook;
+		AnimationIndex = Data.FindAnimationIndexByFlipbook(CurrentFlipbook);
+		bUseFrameLookup = CurrentFlipbook && Data.Animations.IsValidIndex(AnimationIndex)
+			&& Data.Animations[AnimationIndex].IsFrameLookupValidFor(*CurrentFlipbook);
+	}
+
+	FrameIndex = INDEX_NONE;
+	if (CurrentFlipbook && Data.Animations.IsValidIndex(AnimationIndex))
+	{
+		// Precomputed table is a single index; walk the key frames for assets saved without one or with a stale one
+		FrameIndex = bUseFrameLookup
+			? Data.Animations[AnimationIndex].GetFrameIndexAtDisplayFrame(FlipbookComponent.GetPlaybackPositionInFrames())
+			: CurrentFlipbook->GetKeyFrameIndexAtTime(FlipbookComponent.GetPlaybackPosition());
+	}
+
+	const FTransform& Transform = FlipbookComponent.GetComponentTransform();
+	const FVector Location = Transform.GetLocation();
+	const FVector WorldScale = Transform.GetScale3D();
+	Position = FVector2D(Location.X, Location.Z);
+	Depth = Location.Y;
+	Scale = (float)FMath::Abs(WorldScale.X);
+	bFlipX = bAutoFlipX
+		? (WorldScale.X < 0.0f) != (Transform.GetUnitAxis(EAxis::X).X < 0.0f)
+		: bManualFlipX;
+
+	bOutFrameChanged = AnimationIndex != PrevAnimationIndex || FrameIndex != PrevFrameIndex;
+
+	return bOutFrameChanged
+		|| Position != PrevPosition
+		|| bFlipX != bPrevFlipX
+		|| Scale != PrevScale;
+}
+
+bool UHitboxComponent::UpdateFromFlipbook(bool& bOutFrameChanged)
+{
+	bOutFrameChanged = false;
+	if (!FlipbookComponent || !HitboxData) return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitboxComponentUpdate);
+
+	// Depth alone doesn't move the boxes, but sockets report it
+	FHitboxFlipbookState NewState = FlipbookState;
+	const bool bChanged = NewState.Update(*FlipbookComponent, *HitboxData, bAutoFlipX, bFlipX, bOutFrameChanged);
+	if (bChanged)
+	{
+		ApplyFlipbookState(NewState);
+	}
+	else
+	{
+		FlipbookState.Depth = NewState.Depth;
+	}
+	return bChanged;
+}
+
+void UHitboxComponent::ApplyFlipbookState(const FHitboxFlipbookState& NewState)
+{
+	FlipbookState = NewState;
+	CurrentFrame = HitboxData ? HitboxData->GetFramePtr(FlipbookState.AnimationIndex, FlipbookState.FrameIndex) : nullptr;
+	WorldCache.Invalidate();
+	WorldCache.Update(CurrentFrame, FlipbookState.Position, FlipbookState.bFlipX, FlipbookState.Scale);
+}
+
+float UHitboxComponent::GetTimeToNextFrameChange() const
+{
+	if (!FlipbookComponent || !FlipbookComponent->IsPlaying() || !HitboxData) return -1.0f;
+
+	// A Flipbook without hitbox data can't change frames until a different one plays
+	if (!HitboxData->Animations.IsValidIndex(FlipbookState.AnimationIndex)) return -1.0f;
+
+	const FAnimationHitboxData& Anim = HitboxData->Animations[FlipbookState.AnimationIndex];
+	if (!FlipbookState.bUseFrameLookup) return 0.0f;
+
+	const float PlayRate = FlipbookComponent->GetPlayRate();
+	if (PlayRate == 0.0f || Anim.FlipbookFramesPerSecond <= 0.0f) return -1.0f;
+
+	// Walk the display frames in playback direction until the hitbox frame differs
+	const TArray<int32>& Table = Anim.DisplayFrameToHitboxFrame;
+	const int32 NumFrames = Table.Num();
+	const int32 Current = FMath::Clamp(FlipbookComponent->GetPlaybackPositionInFrames(), 0, NumFrames - 1);
+	const bool bForward = PlayRate > 0.0f;
+	const bool bLooping = FlipbookComponent->IsLooping();
+
+	for (int32 Ahead = 1; Ahead < NumFrames; ++Ahead)
+	{
+		int32 Frame = bForward ? Current + Ahead : Current - Ahead;
+		if (Frame < 0 || Frame >= NumFrames)
+		{
+			if (!bLooping) return -1.0f;
+			Frame = (Frame + NumFrames) % NumFrames;
+		}
+
+		if (Table[Frame] != Table[Current])
+		{
+			// Unwrapped playback time at which that display frame is entered
+			const float BoundaryTime = (bForward ? Current + Ahead : Current - Ahead + 1) / Anim.FlipbookFramesPerSecond;
+			const float PlaybackTime = FlipbookComponent->GetPlaybackPosition();
+			const float Delta = bForward ? BoundaryTime - PlaybackTime : PlaybackTime - BoundaryTime;
+			return FMath::Max(Delta / FMath::Abs(PlayRate), 0.0f);
+		}
+	}
+	return -1.0f;
+}
+
+void UHitboxComponent::ScheduleNextRefresh()
+{
+	if (!bEventDrivenUpdates || bBatchedUpdates || !HasBegunPlay()) return;
+
+	float Delay = GetTimeToNextFrameChange();
+
+	// Poll at the fallback rate so playback changed from outside is still noticed
+	if (EventDrivenFallbackInterval > 0.0f)
+	{
+		Delay = Delay < 0.0f ? EventDrivenFallbackInterval : FMath::Min(Delay, EventDrivenFallbackInterval);
+	}
+	else if (Delay < 0.0f)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	SetComponentTickIntervalAndCooldown(Delay);
+	SetComponentTickEnabled(true);
+}
+
+UHitboxWorldSubsystem* UHitboxComponent::GetHitboxSubsystem() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UHitboxWorldSubsystem>() : nullptr;
+}
+
+// ==========================================
+// CURRENT STATE
+// ==========================================
+
+bool UHitboxComponent::GetCurrentFrame(FFrameHitboxData& OutFrame) const
+{
+	if (CurrentFrame)
+	{
+		OutFrame = *CurrentFrame;
+		return true;
+	}
+	return false;
+}
+
+// ==========================================
+// COLLISION
+// ==========================================
+
+bool UHitboxComponent::CheckCollisionAgainst(const UHitboxComponent* Defender, TArray<FHitboxCollisionResult>& OutResults) const
+{
+	OutResults.Reset();
+	if (!Defender) return false;
+
+	return UHitboxBlueprintLibrary::CheckCachedCollision(WorldCache, Defender->WorldCache, OutResults);
+}
+
+bool UHitboxComponent::QuickHitCheckAgainst(const UHitboxComponent* Defender) const
+{
+	if (!Defender) return false;
+
+	return UHitboxBlueprintLibrary::QuickCachedHitCheck(WorldCache, Defender->WorldCache);
+}
+
+bool UHitboxComponent::GetSocketWorldLocation(const FString& SocketName, FVector& OutLocation) const
+{
+	FVector2D SocketPosition;
+	if (!WorldCache.FindSocket(SocketName, SocketPosition)) return false;
+
+	OutLocation = FVector(SocketPosition.X, FlipbookState.Depth, SocketPosition.Y);
+	return true;
+}
@@ -1,4 +1,6 @@
 #include "HitboxDataAsset.h"
+#include "HitboxStats.h"
+#include "UObject/ObjectSaveContext.h"
 
 UHitboxDataAsset::UHitboxDataAsset()
 {
@@ -10,8 +12,61 @@ FPrimaryAssetId UHitboxDataAsset::GetPrimaryAssetId() const
 	return FPrimaryAssetId(TEXT("HitboxData"), GetFName());
 }
 
+#if WITH_EDITOR
+void UHitboxDataAsset::RebuildFrameLookupTables()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::RebuildFrameLookupTables);
+
+	for (FAnimationHitboxData& Anim : Animations)
+	{
+		// Loading here would stall saves and cooks; a Flipbook that isn't loaded can't have been retimed in this session
+		UPaperFlipbook* Flipbook = Anim.Flipbook.Get();
+		if (!Flipbook && !Anim.Flipbook.IsNull()) continue;
+
+		Anim.DisplayFrameToHitboxFrame.Reset();
+		Anim.FlipbookFramesPerSecond = 0.0f;
+		if (!Flipbook) continue;
+
+		Anim.FlipbookFramesPerSecond = Flipbook->GetFramesPerSecond();
+		Anim.DisplayFrameToHitboxFrame.Reserve(Flipbook->GetNumFrames());
+
+		// Hitbox frames are stored one per key frame; a key frame covers FrameRun display frames
+		for (int32 KeyFrameIndex = 0; KeyFrameIndex < Flipbook->GetNumKeyFrames(); ++KeyFrameIndex)
+		{
+			const int32 FrameIndex = Anim.Frames.IsValidIndex(KeyFrameIndex) ? KeyFrameIndex : INDEX_NONE;
+			const int32 FrameRun = Flipbook->GetKeyFrameChecked(KeyFrameIndex).FrameRun;
+			for (int32 Run = 0; Run < FrameRun; ++Run)
+			{
+				Anim.DisplayFrameToHitboxFrame.Add(FrameIndex);
+			}
+		}
+	}
+}
+
+void UHitboxDataAsset::PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeChainProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(FAnimationHitboxData, Flipbook)
+		|| PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UHitboxDataAsset, Animations))
+	{
+		RebuildFrameLookupTables();
+	}
+}
+
+void UHitboxDataAsset::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// Flipbooks may have been retimed since they were linked
+	RebuildFrameLookupTables();
+}
+#endif
+
 const FAnimationHitboxData* UHitboxDataAsset::FindAnimation(const FString& AnimationName) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_HitboxLookup);
+
 	for (const FAnimationHitboxData& Anim : Animations)
 	{
 		if (Anim.AnimationName.Equals(AnimationName, ESearchCase::IgnoreCase))
@@ -37,6 +92,7 @@ bool UHitboxDataAsset::GetAnimation(const FString& AnimationName, FAnimationHitb
 {
 	if (const FAnimationHitboxData* Anim = FindAnimation(AnimationName))
 	{
+		INC_DWORD_STAT(STAT_HitboxTempAllocations);
 		OutAnimation = *Anim;
 		return true;
 	}
@@ -47,6 +103,7 @@ bool UHitboxDataAsset::GetAnimationByIndex(int32 Index, FAnimationHitboxData& Ou
 {
 	if (Animations.IsValidIndex(Index))
 	{
+		INC_DWORD_STAT(STAT_HitboxTempAllocations);
 		OutAnimation = Animations[Index];
 		return true;
 	}
@@ -68,6 +125,7 @@ bool UHitboxDataAsset::GetFrame(const FString& AnimationName, int32 FrameIndex,
 	{
 		if (const FFrameHitboxData* Frame = Anim->GetFrame(FrameIndex))
 		{
+			INC_DWORD_STAT(STAT_HitboxTempAllocations);
 			OutFrame = *Frame;
 			return true;
 		}
@@ -81,6 +139,7 @@ bool UHitboxDataAsset::GetFrameByName(const FString& AnimationName, const FStrin
 	{
 		if (const FFrameHitboxData* Frame = Anim->GetFrameByName(FrameName))
 		{
+			INC_DWORD_STAT(STAT_HitboxTempAllocations);
 			OutFrame = *Frame;
 			return true;
 		}
@@ -90,12 +149,15 @@ bool UHitboxDataAsset::GetFrameByName(const FString& AnimationName, const FStrin
 
 bool UHitboxDataAsset::FindAnimationByFlipbook(UPaperFlipbook* Flipbook, FAnimationHitboxData& OutAnimation) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_HitboxLookup);
+
 	if (!Flipbook) return false;
 
 	for (const FAnimationHitboxData& Anim : Animations)
 	{
 		if (Anim.Flipbook.Get() == Flipbook)
 		{
+			INC_DWORD_STAT(STAT_HitboxTempAllocations);
 			OutAnimation = Anim;
 			return true;
 		}
@@ -103,12 +165,52 @@ bool UHitboxDataAsset::FindAnimationByFlipbook(UPaperFlipbook* Flipbook, FAnimat
 	return false;
 }
 
+int32 UHitboxDataAsset::GetFrameIndexAtTime(const FString& AnimationName, float PlaybackTime) const
+{
+	if (const FAnimationHitboxData* Anim = FindAnimation(AnimationName))
+	{
+		return Anim->GetFrameIndexAtTime(PlaybackTime);
+	}
+	return INDEX_NONE;
+}
+
+int32 UHitboxDataAsset::FindAnimationIndexByFlipbook(const UPaperFlipbook* Flipbook) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxLookup);
+
+	if (!Flipbook) return INDEX_NONE;
+
+	for (int32 Index = 0; Index < Animations.Num(); ++Index)
+	{
+		if (Animations[Index].Flipbook.Get() == Flipbook)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 UHitboxDataAsset::FindAnimationIndex(const FString& AnimationName) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxLookup);
+
+	for (int32 Index = 0; Index < Animations.Num(); ++Index)
+	{
+		if (Animations[Index].AnimationName.Equals(AnimationName, ESearchCase::IgnoreCase))
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
 TArray<FHitboxData> UHitboxDataAsset::GetHitboxes(const FString& AnimationName, int32 FrameIndex) const
 {
 	if (const FAnimationHitboxData* Anim = FindAnimation(AnimationName))
 	{
 		if (const FFrameHitboxData* Frame = Anim->GetFrame(FrameIndex))
 		{
+			INC_DWORD_STAT(STAT_HitboxTempAllocations);
 			return Frame->Hitboxes;
 		}
 	}
@@ -121,6 +223,7 @@ TArray<FHitboxData> UHitboxDataAsset::GetHitboxesByType(const FString& Animation
 	{
 		if (const FFrameHitboxData* Frame = Anim->GetFrame(FrameIndex))
 		{
+			INC_DWORD_STAT(STAT_HitboxTempAllocations);
 			return Frame->GetHitboxesByType(Type);
 		}
 	}
@@ -133,6 +236,7 @@ TArray<FSocketData> UHitboxDataAsset::GetSockets(const FString& AnimationName, i
 	{
 		if (const FFrameHitboxData* Frame = Anim->GetFrame(FrameIndex))
 		{
+			INC_DWORD_STAT(STAT_HitboxTempAllocations);
 			return Frame->Sockets;
 		}
 	}
@@ -159,3 +263,66 @@ bool UHitboxDataAsset::HasAnimation(const FString& AnimationName) const
 {
 	return FindAnimation(AnimationName) != nullptr;
 }
+
+// ==========================================
+// MEMORY
+// ==========================================
+
+FHitboxAssetMemory FAnimationHitboxData::GetMemoryUsage() const
+{
+	FHitboxAssetMemory Memory;
+	Memory.Names += AnimationName.GetAllocatedSize();
+	Memory.Containers += Frames.GetAllocatedSize();
+	Memory.LookupTables += DisplayFrameToHitboxFrame.GetAllocatedSize();
+
+	for (const FFrameHitboxData& Frame : Frames)
+	{
+		Memory.Names += Frame.FrameName.GetAllocatedSize();
+		Memory.Boxes += Frame.Hitboxes.GetAllocatedSize();
+		Memory.Sockets += Frame.Sockets.GetAllocatedSize();
+		for (const FSocketData& Socket : Frame.Sockets)
+		{
+			Memory.Names += Socket.Name.GetAllocatedSize();
+		}
+	}
+	return Memory;
+}
+
+FHitboxAssetMemory UHitboxDataAsset::GetMemoryUsage() const
+{
+	FHitboxAssetMemory Memory;
+	Memory.Object = GetClass()->GetStructureSize();
+	Memory.Containers += Animations.GetAllocatedSize();
+	Memory.Names += DisplayName.GetAllocatedSize();
+
+	// Not editor-only: the source path is a plain property and ships with cooked assets
+	Memory.Names += SourceFilePath.GetAllocatedSize();
+#if WITH_EDITORONLY_DATA
+	Memory.EditorData += AssetBundleData.Bundles.GetAllocatedSize();
+#endif
+
+	for (const FAnimationHitboxData& Anim : Animations)
+	{
+		Memory += Anim.GetMemoryUsage();
+	}
+	return Memory;
+}
+
+void UHitboxDataAsset::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	// Counted field by field rather than through the serialization estimate, so the breakdown is exact.
+	// Flipbooks are soft references and not part of this asset's size.
+	const FHitboxAssetMemory Memory = GetMemoryUsage();
+
+	// Exclusive size is what the asset owns beyond its object, like the engine's own GetResourceSizeEx overrides
+	if (CumulativeResourceSize.GetResourceSizeMode() == EResourceSizeMode::EstimatedTotal)
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("Object"), Memory.Object);
+	}
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("Boxes"), Memory.Boxes);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("Sockets"), Memory.Sockets);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("Names"), Memory.Names);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("LookupTables"), Memory.LookupTables);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("Containers"), Memory.Containers);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TEXT("EditorData"), Memory.EditorData);
+}
@@ -0,0 +1,101 @@
+#include "HitboxReplication.h"
+#include "GameFramework/Actor.h"
+#include "UObject/CoreNet.h"
+
+// ==========================================
+// QUANTIZATION
+// ==========================================
+
+/** Signed value as a packed int (zigzag, so small magnitudes of either sign stay short) */
+static void SerializeSignedPacked(FArchive& Ar, int32& Value)
+{
+	uint32 Encoded = Ar.IsSaving() ? ((uint32)Value << 1) ^ (uint32)(Value >> 31) : 0;
+	Ar.SerializeIntPacked(Encoded);
+	if (Ar.IsLoading())
+	{
+		Value = (int32)(Encoded >> 1) ^ -(int32)(Encoded & 1);
+	}
+}
+
+/** Index that may be -1, sent as Index + 1 */
+static void SerializeIndexPacked(FArchive& Ar, int32& Index)
+{
+	uint32 Encoded = Ar.IsSaving() ? (uint32)FMath::Max(Index + 1, 0) : 0;
+	Ar.SerializeIntPacked(Encoded);
+	if (Ar.IsLoading())
+	{
+		Index = (int32)Encoded - 1;
+	}
+}
+
+// ==========================================
+// STATE
+// ==========================================
+
+bool FHitboxReplicatedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	int32 QuantizedX = Ar.IsSaving() ? FMath::RoundToInt32(Position.X * 10.0) : 0;
+	int32 QuantizedY = Ar.IsSaving() ? FMath::RoundToInt32(Position.Y * 10.0) : 0;
+	SerializeSignedPacked(Ar, QuantizedX);
+	SerializeSignedPacked(Ar, QuantizedY);
+
+	uint8 FlipBit = bFlipX ? 1 : 0;
+	Ar.SerializeBits(&FlipBit, 1);
+
+	uint8 ScaleIndex = Ar.IsSaving() ? (uint8)FMath::Clamp(FMath::RoundToInt32(Scale * 16.0f), 0, 255) : 0;
+	Ar << ScaleIndex;
+
+	SerializeIndexPacked(Ar, AnimationIndex);
+	SerializeIndexPacked(Ar, FrameIndex);
+
+	if (Ar.IsLoading())
+	{
+		Position = FVector2D(QuantizedX * 0.1, QuantizedY * 0.1);
+		bFlipX = (FlipBit & 1) != 0;
+		Scale = ScaleIndex / 16.0f;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+// ==========================================
+// HITS
+// ==========================================
+
+bool FHitboxReplicatedHit::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	UObject* AttackerObject = Attacker;
+	UObject* DefenderObject = Defender;
+	bOutSuccess &= Map->SerializeObject(Ar, AActor::StaticClass(), AttackerObject);
+	bOutSuccess &= Map->SerializeObject(Ar, AActor::StaticClass(), DefenderObject);
+
+	SerializeIndexPacked(Ar, AttackerAnimationIndex);
+	SerializeIndexPacked(Ar, AttackerFrameIndex);
+	SerializeIndexPacked(Ar, DefenderAnimationIndex);
+	SerializeIndexPacked(Ar, DefenderFrameIndex);
+
+	uint8 AttackIndex = (uint8)FMath::Clamp(AttackHitboxIndex, 0, 255);
+	uint8 HurtIndex = (uint8)FMath::Clamp(HurtHitboxIndex, 0, 255);
+	Ar << AttackIndex;
+	Ar << HurtIndex;
+
+	int16 OffsetX = (int16)FMath::Clamp(FMath::RoundToInt32(HitOffset.X), -32767, 32767);
+	int16 OffsetY = (int16)FMath::Clamp(FMath::RoundToInt32(HitOffset.Y), -32767, 32767);
+	Ar << OffsetX;
+	Ar << OffsetY;
+
+	if (Ar.IsLoading())
+	{
+		Attacker = Cast<AActor>(AttackerObject);
+		Defender = Cast<AActor>(DefenderObject);
+		AttackHitboxIndex = AttackIndex;
+		HurtHitboxIndex = HurtIndex;
+		HitOffset = FVector2D(OffsetX, OffsetY);
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return true;
+}
@@ -0,0 +1,107 @@
+#include "HitboxWorldSubsystem.h"
+#include "HitboxSnapshot.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * Measures a rollback of hitbox state: save, simulate N frames, restore and resimulate the same N frames.
+ * Participants are moved and animated between frames so every resimulated step rebuilds boxes and the grid.
+ * Run in PIE or a game world (an empty map with -nullrhi works for headless runs).
+ */
+static FAutoConsoleCommandWithWorldAndArgs HitboxRollbackBenchmarkCommand(
+	TEXT("hitbox.Rollback.Benchmark"),
+	TEXT("Benchmark hitbox SaveState/LoadState and resimulation. Usage: hitbox.Rollback.Benchmark <AssetPath> [Participants=64] [Frames=8] [Iterations=200] [Seed=0]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UHitboxWorldSubsystem* Subsystem = World ? World->GetSubsystem<UHitboxWorldSubsystem>() : nullptr;
+		if (!Subsystem || Args.Num() < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("hitbox.Rollback.Benchmark: needs a game world and an asset path"));
+			return;
+		}
+
+		UHitboxDataAsset* Asset = LoadObject<UHitboxDataAsset>(nullptr, *Args[0]);
+		if (!Asset || Asset->Animations.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("hitbox.Rollback.Benchmark: could not load hitbox asset '%s'"), *Args[0]);
+			return;
+		}
+
+		const int32 Count = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 64;
+		const int32 Frames = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 8;
+		const int32 Iterations = Args.Num() > 3 ? FMath::Max(FCString::Atoi(*Args[3]), 1) : 200;
+		FRandomStream Random(Args.Num() > 4 ? FCString::Atoi(*Args[4]) : 0);
+		const float DeltaTime = 1.0f / 60.0f;
+
+		// Participants need distinct owners to hit each other
+		TArray<AActor*> Owners;
+		TArray<int32> Ids;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			AActor* Owner = World->SpawnActor<AActor>();
+			const int32 AnimationIndex = Random.RandRange(0, Asset->Animations.Num() - 1);
+			const int32 Id = Subsystem->RegisterParticipant(Owner, Asset, 1 + (Index & 1));
+			Subsystem->SetParticipantFrame(Id, AnimationIndex, 0);
+			Subsystem->SetParticipantTransform(Id, FVector2D(Random.FRandRange(-1000.0f, 1000.0f), 0.0f), Random.RandRange(0, 1) == 1);
+			Owners.Add(Owner);
+			Ids.Add(Id);
+		}
+
+		// Deterministic per-frame input so the resimulated frames match the originals
+		auto StepFrame = [&](int32 Frame)
+		{
+			for (int32 Index = 0; Index < Ids.Num(); ++Index)
+			{
+				const FHitboxParticipant* Participant = Subsystem->FindParticipant(Ids[Index]);
+				const int32 NumFrames = Asset->Animations[Participant->AnimationIndex].Frames.Num();
+				Subsystem->SetParticipantFrame(Ids[Index], Participant->AnimationIndex, NumFrames > 0 ? (Frame + Index) % NumFrames : 0);
+				Subsystem->SetParticipantTransform(Ids[Index], Participant->Position + FVector2D((Index & 1) ? -2.0 : 2.0, 0.0), Participant->bFlipX);
+			}
+			Subsystem->AdvanceSimulation(DeltaTime);
+		};
+
+		FHitboxWorldSnapshot Snapshot;
+		Subsystem->SaveState(Snapshot);
+
+		double SaveSeconds = 0.0;
+		double LoadSeconds = 0.0;
+		double ResimulateSeconds = 0.0;
+
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			double Start = FPlatformTime::Seconds();
+			Subsystem->SaveState(Snapshot);
+			SaveSeconds += FPlatformTime::Seconds() - Start;
+
+			for (int32 Frame = 0; Frame < Frames; ++Frame)
+			{
+				StepFrame(Frame);
+			}
+
+			Start = FPlatformTime::Seconds();
+			Subsystem->LoadState(Snapshot);
+			LoadSeconds += FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < Frames; ++Frame)
+			{
+				StepFrame(Frame);
+			}
+			ResimulateSeconds += FPlatformTime::Seconds() - Start;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("hitbox.Rollback.Benchmark: %d participants, %d frames, %d iterations, snapshot %llu bytes"),
+			Count, Frames, Iterations, (uint64)Snapshot.GetAllocatedSize());
+		UE_LOG(LogTemp, Log, TEXT("hitbox.Rollback.Benchmark: save %.2f us, load %.2f us, resimulate %d frames %.2f us (per rollback)"),
+			SaveSeconds * 1e6 / Iterations, LoadSeconds * 1e6 / Iterations, Frames, ResimulateSeconds * 1e6 / Iterations);
+
+		for (int32 Index = 0; Index < Ids.Num(); ++Index)
+		{
+			Subsystem->UnregisterParticipant(Ids[Index]);
+			Owners[Index]->Destroy();
+		}
+	}),
+	ECVF_Cheat
+);
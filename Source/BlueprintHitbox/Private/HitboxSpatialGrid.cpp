@@ -0,0 +1,169 @@
+#include "HitboxSpatialGrid.h"
+#include "Algo/Sort.h"
+
+void FHitboxSpatialGrid::Reset(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	ItemBounds.Reset();
+	CellEntries.Reset();
+	CellHeads.Reset();
+	FreeItems.Reset();
+	FreeEntry = INDEX_NONE;
+	QueryStamps.Reset();
+	CurrentStamp = 0;
+	NumBoundsTests = 0;
+}
+
+FIntPoint FHitboxSpatialGrid::GetCell(const FVector2D& Point) const
+{
+	return FIntPoint(FMath::FloorToInt32(Point.X / CellSize), FMath::FloorToInt32(Point.Y / CellSize));
+}
+
+int32 FHitboxSpatialGrid::Insert(const FBox2D& Box)
+{
+	// Stamps of reused items are from earlier queries, so they can't match the next query's stamp
+	int32 Item;
+	if (FreeItems.Num() > 0)
+	{
+		Item = FreeItems.Pop();
+		ItemBounds[Item] = Box;
+	}
+	else
+	{
+		Item = ItemBounds.Add(Box);
+		QueryStamps.Add(0);
+	}
+
+	const FIntPoint MinCell = GetCell(Box.Min);
+	const FIntPoint MaxCell = GetCell(Box.Max);
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			int32& Head = CellHeads.FindOrAdd(FIntPoint(CellX, CellY), INDEX_NONE);
+			int32 Entry = FreeEntry;
+			if (Entry != INDEX_NONE)
+			{
+				FreeEntry = CellEntries[Entry].Next;
+				CellEntries[Entry] = { Item, Head };
+			}
+			else
+			{
+				Entry = CellEntries.Add({ Item, Head });
+			}
+			Head = Entry;
+		}
+	}
+
+	return Item;
+}
+
+void FHitboxSpatialGrid::Remove(int32 Item)
+{
+	if (!ItemBounds.IsValidIndex(Item) || !ItemBounds[Item].bIsValid) return;
+
+	FBox2D& Box = ItemBounds[Item];
+	const FIntPoint MinCell = GetCell(Box.Min);
+	const FIntPoint MaxCell = GetCell(Box.Max);
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			const FIntPoint Cell(CellX, CellY);
+			int32* Head = CellHeads.Find(Cell);
+			if (!Head) continue;
+
+			// Unlink the item's entry and put it on the free list
+			for (int32* Link = Head; *Link != INDEX_NONE; Link = &CellEntries[*Link].Next)
+			{
+				const int32 Entry = *Link;
+				if (CellEntries[Entry].Item != Item) continue;
+
+				*Link = CellEntries[Entry].Next;
+				CellEntries[Entry].Next = FreeEntry;
+				FreeEntry = Entry;
+				break;
+			}
+
+			// Empty cells are dropped so the map doesn't grow with every cell anything ever passed through
+			if (*Head == INDEX_NONE)
+			{
+				CellHeads.Remove(Cell);
+			}
+		}
+	}
+
+	Box.bIsValid = false;
+	FreeItems.Add(Item);
+}
+
+template <typename FilterType>
+void FHitboxSpatialGrid::QueryItems(const FBox2D& Box, TArray<int32>& OutItems, const FilterType& Filter) const
+{
+	const int32 FirstResult = OutItems.Num();
+
+	const FIntPoint MinCell = GetCell(Box.Min);
+	const FIntPoint MaxCell = GetCell(Box.Max);
+	const int64 NumCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	if (NumCells > MaxQueryCells)
+	{
+		// Huge query: a linear scan is cheaper than visiting mostly empty cells
+		for (int32 Item = 0; Item < ItemBounds.Num(); ++Item)
+		{
+			if (!ItemBounds[Item].bIsValid || !Filter(Item)) continue;
+
+			++NumBoundsTests;
+			if (ItemBounds[Item].Intersect(Box))
+			{
+				OutItems.Add(Item);
+			}
+		}
+		return;
+	}
+
+	if (++CurrentStamp == 0)
+	{
+		// Stamp wrapped around, clear stale marks
+		FMemory::Memzero(QueryStamps.GetData(), QueryStamps.Num() * sizeof(uint32));
+		CurrentStamp = 1;
+	}
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			const int32* Head = CellHeads.Find(FIntPoint(CellX, CellY));
+			for (int32 Entry = Head ? *Head : INDEX_NONE; Entry != INDEX_NONE; Entry = CellEntries[Entry].Next)
+			{
+				const int32 Item = CellEntries[Entry].Item;
+				if (QueryStamps[Item] == CurrentStamp) continue;
+
+				QueryStamps[Item] = CurrentStamp;
+				if (!Filter(Item)) continue;
+
+				++NumBoundsTests;
+				if (ItemBounds[Item].Intersect(Box))
+				{
+					OutItems.Add(Item);
+				}
+			}
+		}
+	}
+
+	// Callers rely on item order for deterministic results
+	if (OutItems.Num() - FirstResult > 1)
+	{
+		Algo::Sort(MakeArrayView(OutItems.GetData() + FirstResult, OutItems.Num() - FirstResult));
+	}
+}
+
+void FHitboxSpatialGrid::Query(const FBox2D& Box, TArray<int32>& OutItems) const
+{
+	QueryItems(Box, OutItems, [](int32 Item) { return true; });
+}
+
+void FHitboxSpatialGrid::Query(const FBox2D& Box, TArray<int32>& OutItems, TFunctionRef<bool(int32 Item)> Filter) const
+{
+	QueryItems(Box, OutItems, Filter);
+}
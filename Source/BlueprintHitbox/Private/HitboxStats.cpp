@@ -0,0 +1,21 @@
+#include "HitboxStats.h"
+
+CSV_DEFINE_CATEGORY(Hitbox, true);
+
+DEFINE_STAT(STAT_HitboxWorldTick);
+DEFINE_STAT(STAT_HitboxManagedUpdate);
+DEFINE_STAT(STAT_HitboxComponentUpdate);
+DEFINE_STAT(STAT_HitboxSpatialIndex);
+DEFINE_STAT(STAT_HitboxProcessHits);
+DEFINE_STAT(STAT_HitboxDispatchHits);
+DEFINE_STAT(STAT_HitboxProjectiles);
+DEFINE_STAT(STAT_HitboxQueries);
+DEFINE_STAT(STAT_HitboxNarrowphase);
+DEFINE_STAT(STAT_HitboxWorldSpace);
+DEFINE_STAT(STAT_HitboxLookup);
+
+DEFINE_STAT(STAT_HitboxParticipants);
+DEFINE_STAT(STAT_HitboxPairsTested);
+DEFINE_STAT(STAT_HitboxBoxesTransformed);
+DEFINE_STAT(STAT_HitboxHits);
+DEFINE_STAT(STAT_HitboxTempAllocations);
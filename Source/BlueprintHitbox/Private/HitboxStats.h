@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// View with "stat Hitbox"; counters are reset every frame
+DECLARE_STATS_GROUP(TEXT("Hitbox"), STATGROUP_Hitbox, STATCAT_Advanced);
+
+// Hitbox columns in -csvprofile captures, available in builds without stats (Test, dedicated servers)
+CSV_DECLARE_CATEGORY_EXTERN(Hitbox);
+
+// ==========================================
+// CYCLE COUNTERS
+// ==========================================
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Tick"), STAT_HitboxWorldTick, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Component Updates"), STAT_HitboxManagedUpdate, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Component Update"), STAT_HitboxComponentUpdate, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Index Update"), STAT_HitboxSpatialIndex, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit Processing"), STAT_HitboxProcessHits, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit Dispatch"), STAT_HitboxDispatchHits, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectiles"), STAT_HitboxProjectiles, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Queries"), STAT_HitboxQueries, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Narrowphase"), STAT_HitboxNarrowphase, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Space Conversion"), STAT_HitboxWorldSpace, STATGROUP_Hitbox, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Asset Lookup"), STAT_HitboxLookup, STATGROUP_Hitbox, );
+
+// ==========================================
+// COUNTERS
+// ==========================================
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Participants"), STAT_HitboxParticipants, STATGROUP_Hitbox, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Box Pairs Tested"), STAT_HitboxPairsTested, STATGROUP_Hitbox, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Boxes Transformed"), STAT_HitboxBoxesTransformed, STATGROUP_Hitbox, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hits Produced"), STAT_HitboxHits, STATGROUP_Hitbox, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Temporary Allocations"), STAT_HitboxTempAllocations, STATGROUP_Hitbox, );
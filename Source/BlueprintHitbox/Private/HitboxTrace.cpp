@@ -0,0 +1,104 @@
+#include "HitboxTrace.h"
+#include "HitboxParticipant.h"
+#include "HitboxDataAsset.h"
+#include "HitboxTypes.h"
+#include "HAL/PlatformTime.h"
+
+UE_TRACE_CHANNEL_DEFINE(HitboxChannel)
+
+// Important so the analyzer can name assets even when tracing starts late
+UE_TRACE_EVENT_BEGIN(Hitbox, Asset, NoSync|Important)
+	UE_TRACE_EVENT_FIELD(int32, AssetIndex)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Hitbox, Tick, NoSync)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(double, SimulationTime)
+	UE_TRACE_EVENT_FIELD(uint32, TickCounter)
+	UE_TRACE_EVENT_FIELD(uint32, NumParticipants)
+	UE_TRACE_EVENT_FIELD(uint32, NumHurtboxes)
+UE_TRACE_EVENT_END()
+
+// Flags: bit 0 flipped, bit 1 attack active, bits 2-3 processing tier
+UE_TRACE_EVENT_BEGIN(Hitbox, Participant, NoSync)
+	UE_TRACE_EVENT_FIELD(int32, Id)
+	UE_TRACE_EVENT_FIELD(int16, AssetIndex)
+	UE_TRACE_EVENT_FIELD(int16, AnimationIndex)
+	UE_TRACE_EVENT_FIELD(int16, FrameIndex)
+	UE_TRACE_EVENT_FIELD(uint8, Flags)
+	UE_TRACE_EVENT_FIELD(float, X)
+	UE_TRACE_EVENT_FIELD(float, Y)
+	UE_TRACE_EVENT_FIELD(float, Scale)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Hitbox, Attack, NoSync)
+	UE_TRACE_EVENT_FIELD(int32, AttackerId)
+	UE_TRACE_EVENT_FIELD(int32, AttackId)
+	UE_TRACE_EVENT_FIELD(int16, AttackHitboxIndex)
+	UE_TRACE_EVENT_FIELD(uint16, NumCandidates)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Hitbox, Hit, NoSync)
+	UE_TRACE_EVENT_FIELD(int32, AttackerId)
+	UE_TRACE_EVENT_FIELD(int32, DefenderId)
+	UE_TRACE_EVENT_FIELD(int16, AttackHitboxIndex)
+	UE_TRACE_EVENT_FIELD(int16, HurtHitboxIndex)
+	UE_TRACE_EVENT_FIELD(int32, Damage)
+UE_TRACE_EVENT_END()
+
+void FHitboxTrace::OutputAsset(int32 AssetIndex, const UHitboxDataAsset* HitboxAsset)
+{
+	if (!HitboxAsset || !IsEnabled()) return;
+
+	const FString Name = HitboxAsset->GetPathName();
+	UE_TRACE_LOG(Hitbox, Asset, HitboxChannel)
+		<< Asset.AssetIndex(AssetIndex)
+		<< Asset.Name(*Name, Name.Len());
+}
+
+void FHitboxTrace::OutputTick(uint32 TickCounter, double SimulationTime, int32 NumParticipants, int32 NumHurtboxes)
+{
+	UE_TRACE_LOG(Hitbox, Tick, HitboxChannel)
+		<< Tick.Cycle(FPlatformTime::Cycles64())
+		<< Tick.SimulationTime(SimulationTime)
+		<< Tick.TickCounter(TickCounter)
+		<< Tick.NumParticipants((uint32)NumParticipants)
+		<< Tick.NumHurtboxes((uint32)NumHurtboxes);
+}
+
+void FHitboxTrace::OutputParticipant(const FHitboxParticipant& State)
+{
+	const uint8 Flags = (State.bFlipX ? 1 : 0)
+		| (State.bAttackActive ? 2 : 0)
+		| ((uint8)State.Tier << 2);
+
+	UE_TRACE_LOG(Hitbox, Participant, HitboxChannel)
+		<< Participant.Id(State.Id)
+		<< Participant.AssetIndex((int16)State.AssetIndex)
+		<< Participant.AnimationIndex((int16)State.AnimationIndex)
+		<< Participant.FrameIndex((int16)State.FrameIndex)
+		<< Participant.Flags(Flags)
+		<< Participant.X((float)State.Position.X)
+		<< Participant.Y((float)State.Position.Y)
+		<< Participant.Scale(State.Scale);
+}
+
+void FHitboxTrace::OutputAttack(int32 AttackerId, int32 AttackId, int32 AttackHitboxIndex, int32 NumCandidates)
+{
+	UE_TRACE_LOG(Hitbox, Attack, HitboxChannel)
+		<< Attack.AttackerId(AttackerId)
+		<< Attack.AttackId(AttackId)
+		<< Attack.AttackHitboxIndex((int16)AttackHitboxIndex)
+		<< Attack.NumCandidates((uint16)FMath::Min(NumCandidates, (int32)MAX_uint16));
+}
+
+void FHitboxTrace::OutputHit(const FHitboxHitEvent& HitEvent)
+{
+	UE_TRACE_LOG(Hitbox, Hit, HitboxChannel)
+		<< Hit.AttackerId(HitEvent.AttackerParticipantId)
+		<< Hit.DefenderId(HitEvent.DefenderParticipantId)
+		<< Hit.AttackHitboxIndex((int16)HitEvent.AttackHitboxIndex)
+		<< Hit.HurtHitboxIndex((int16)HitEvent.HurtHitboxIndex)
+		<< Hit.Damage(HitEvent.Result.Damage);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+class UHitboxDataAsset;
+struct FHitboxParticipant;
+struct FHitboxHitEvent;
+
+UE_TRACE_CHANNEL_EXTERN(HitboxChannel);
+
+/**
+ * Per-tick hitbox activity on the Hitbox trace channel (-trace=default,hitbox).
+ * Callers check IsEnabled first so nothing is gathered while the channel is off.
+ */
+struct FHitboxTrace
+{
+	static bool IsEnabled() { return UE_TRACE_CHANNELEXPR_IS_ENABLED(HitboxChannel); }
+
+	/** Asset name for an asset index, sent when the asset is first registered and for all assets when the channel turns on */
+	static void OutputAsset(int32 AssetIndex, const UHitboxDataAsset* HitboxAsset);
+
+	/** Starts a processed tick; the participant, attack and hit events that follow belong to it */
+	static void OutputTick(uint32 TickCounter, double SimulationTime, int32 NumParticipants, int32 NumHurtboxes);
+
+	static void OutputParticipant(const FHitboxParticipant& State);
+
+	/** An attack box tested against the grid and the number of candidate hurtboxes it returned */
+	static void OutputAttack(int32 AttackerId, int32 AttackId, int32 AttackHitboxIndex, int32 NumCandidates);
+
+	static void OutputHit(const FHitboxHitEvent& HitEvent);
+};
@@ -0,0 +1,52 @@
+#include "HitboxWorldCache.h"
+#include "HitboxBlueprintLibrary.h"
+#include "HitboxStats.h"
+
+bool FHitboxWorldCache::Update(const FFrameHitboxData* InFrame, FVector2D Position, bool bFlipX, float Scale)
+{
+	if (!bDirty && Frame == InFrame) return false;
+	bDirty = false;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitboxWorldSpace);
+
+	Frame = InFrame;
+	Boxes.Reset();
+	Sockets.Reset();
+	AttackBounds = FBox2D(ForceInit);
+	HurtBounds = FBox2D(ForceInit);
+	if (!Frame) return true;
+
+	INC_DWORD_STAT_BY(STAT_HitboxBoxesTransformed, Frame->Hitboxes.Num());
+
+	Boxes.Reserve(Frame->Hitboxes.Num());
+	for (const FHitboxData& Hitbox : Frame->Hitboxes)
+	{
+		const FBox2D& World = Boxes.Add_GetRef(UHitboxBlueprintLibrary::HitboxToWorldSpace(Hitbox, Position, bFlipX, Scale));
+		if (Hitbox.Type == EHitboxType::Attack)
+		{
+			AttackBounds += World;
+		}
+		else if (Hitbox.Type == EHitboxType::Hurtbox)
+		{
+			HurtBounds += World;
+		}
+	}
+
+	Sockets.Reserve(Frame->Sockets.Num());
+	for (const FSocketData& Socket : Frame->Sockets)
+	{
+		Sockets.Add(UHitboxBlueprintLibrary::SocketToWorldSpace(Socket, Position, bFlipX, Scale));
+	}
+	return true;
+}
+
+bool FHitboxWorldCache::FindSocket(const FString& SocketName, FVector2D& OutPosition) const
+{
+	if (!Frame) return false;
+
+	const FSocketData* Socket = Frame->FindSocket(SocketName);
+	if (!Socket) return false;
+
+	OutPosition = Sockets[Socket - Frame->Sockets.GetData()];
+	return true;
+}
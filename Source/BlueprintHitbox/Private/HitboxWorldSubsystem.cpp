@@ -0,0 +1,1752 @@
+#include "HitboxWorldSubsystem.h"
+#include "HitboxBlueprintLibrary.h"
+#include "HitboxComponent.h"
+#include "HitboxSnapshot.h"
+#include "HitboxStats.h"
+#include "HitboxTrace.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "VisualLogger/VisualLogger.h"
+#include "Components/LineBatchComponent.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Algo/Sort.h"
+#include "Algo/Rotate.h"
+
+/** Scratch arrays are reused between ticks, so they only allocate when a pass needs more room than any pass before */
+static FORCEINLINE void CountScratchGrowth(int32 PreviousMax, int32 NewMax)
+{
+	INC_DWORD_STAT_BY(STAT_HitboxTempAllocations, NewMax != PreviousMax ? 1 : 0);
+}
+
+static TAutoConsoleVariable<float> CVarHitboxGridCellSize(
+	TEXT("hitbox.GridCellSize"),
+	256.0f,
+	TEXT("Cell size (world units) of the spatial grid used for world hit processing and hurtbox queries."),
+	ECVF_Default);
+
+#if ENABLE_VISUAL_LOG
+DEFINE_LOG_CATEGORY_STATIC(LogHitbox, Log, All);
+
+static TAutoConsoleVariable<bool> CVarHitboxVisLog(
+	TEXT("hitbox.VisLog"),
+	false,
+	TEXT("Record participant world boxes, sockets and hits to the Visual Logger (category LogHitbox) while it is recording."),
+	ECVF_Default);
+#endif
+
+#if ENABLE_DRAW_DEBUG
+static int32 GHitboxDebugDraw = 0;
+static FAutoConsoleVariableRef CVarHitboxDebugDraw(
+	TEXT("hitbox.DebugDraw"),
+	GHitboxDebugDraw,
+	TEXT("Draw participant boxes and sockets in one line batch per tick. 0: off, 1: boxes and sockets, 2: also this tick's hits."),
+	ECVF_Cheat);
+
+/** Lines of the last debug draw, capacity kept between ticks (game thread only) */
+static TArray<FBatchedLine> GHitboxDebugLines;
+#endif
+
+static FAutoConsoleCommandWithWorldAndArgs HitboxCaptureStartCommand(
+	TEXT("hitbox.Capture.Start"),
+	TEXT("Record hitbox collision inputs every tick for the HitboxReplay commandlet. Usage: hitbox.Capture.Start [Filename] (default Saved/Profiling/Hitbox-<time>.hbxcap)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UHitboxWorldSubsystem* Subsystem = World ? World->GetSubsystem<UHitboxWorldSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("hitbox.Capture.Start: needs a game world"));
+			return;
+		}
+
+		const FString Filename = Args.Num() > 0
+			? Args[0]
+			: FPaths::Combine(FPaths::ProfilingDir(), FString::Printf(TEXT("Hitbox-%s.hbxcap"), *FDateTime::Now().ToString()));
+		if (Subsystem->StartCapture(Filename))
+		{
+			UE_LOG(LogTemp, Log, TEXT("hitbox.Capture.Start: recording to %s"), *Filename);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("hitbox.Capture.Start: could not create '%s'"), *Filename);
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorld HitboxCaptureStopCommand(
+	TEXT("hitbox.Capture.Stop"),
+	TEXT("Stop recording hitbox collision inputs."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UHitboxWorldSubsystem* Subsystem = World ? World->GetSubsystem<UHitboxWorldSubsystem>() : nullptr)
+		{
+			Subsystem->StopCapture();
+		}
+	})
+);
+
+// ==========================================
+// PARTICIPANTS
+// ==========================================
+
+bool UHitboxWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UHitboxWorldSubsystem::RegisterParticipant(AActor* Owner, UHitboxDataAsset* Asset, int32 Team)
+{
+	if (!Owner || !Asset) return INDEX_NONE;
+
+	const int32 Index = Participants.AddDefaulted();
+	FHitboxParticipant& Participant = Participants[Index];
+	Participant.Id = NextParticipantId++;
+	Participant.TierPhase = Participant.Id;
+	Participant.Owner = Owner;
+	Participant.Asset = Asset;
+	Participant.Team = Team;
+
+	int32& AssetIndex = AssetIndices.FindOrAdd(Asset, INDEX_NONE);
+	if (AssetIndex == INDEX_NONE)
+	{
+		AssetIndex = Assets.Add(Asset);
+		FHitboxTrace::OutputAsset(AssetIndex, Asset);
+	}
+	Participant.AssetIndex = AssetIndex;
+	ParticipantIndices.Add(Participant.Id, Index);
+	MarkParticipantDirty(Participant);
+
+	return Participant.Id;
+}
+
+void UHitboxWorldSubsystem::UnregisterParticipant(int32 ParticipantId)
+{
+	int32 Index = INDEX_NONE;
+	if (!ParticipantIndices.RemoveAndCopyValue(ParticipantId, Index)) return;
+
+	RemoveFromSpatialIndex(Participants[Index]);
+	if (ManagedStates.IsValidIndex(Participants[Index].ManagedIndex))
+	{
+		ManagedStates[Participants[Index].ManagedIndex].ParticipantIndex = INDEX_NONE;
+	}
+
+	Participants.RemoveAtSwap(Index);
+	if (Participants.IsValidIndex(Index))
+	{
+		FHitboxParticipant& Moved = Participants[Index];
+		ParticipantIndices[Moved.Id] = Index;
+		for (const int32 Item : Moved.GridItems)
+		{
+			HurtboxEntries[Item].ParticipantIndex = Index;
+		}
+		if (ManagedStates.IsValidIndex(Moved.ManagedIndex))
+		{
+			ManagedStates[Moved.ManagedIndex].ParticipantIndex = Index;
+		}
+	}
+}
+
+bool UHitboxWorldSubsystem::SetParticipantFrame(int32 ParticipantId, int32 AnimationIndex, int32 FrameIndex)
+{
+	FHitboxParticipant* Participant = FindParticipantMutable(ParticipantId);
+	if (!Participant) return false;
+
+	if (Participant->AnimationIndex != AnimationIndex || Participant->FrameIndex != FrameIndex)
+	{
+		Participant->AnimationIndex = AnimationIndex;
+		Participant->FrameIndex = FrameIndex;
+		MarkParticipantDirty(*Participant);
+	}
+	return Participant->GetFrame() != nullptr;
+}
+
+bool UHitboxWorldSubsystem::SetParticipantTransform(int32 ParticipantId, FVector2D Position, bool bFlipX, float Scale)
+{
+	FHitboxParticipant* Participant = FindParticipantMutable(ParticipantId);
+	if (!Participant) return false;
+
+	if (Participant->Position != Position || Participant->bFlipX != bFlipX || Participant->Scale != Scale)
+	{
+		Participant->Position = Position;
+		Participant->bFlipX = bFlipX;
+		Participant->Scale = Scale;
+		MarkParticipantDirty(*Participant);
+	}
+	return true;
+}
+
+const FHitboxParticipant* UHitboxWorldSubsystem::FindParticipant(int32 ParticipantId) const
+{
+	const int32* Index = ParticipantIndices.Find(ParticipantId);
+	return Index ? &Participants[*Index] : nullptr;
+}
+
+FHitboxParticipant* UHitboxWorldSubsystem::FindParticipantMutable(int32 ParticipantId)
+{
+	const int32* Index = ParticipantIndices.Find(ParticipantId);
+	return Index ? &Participants[*Index] : nullptr;
+}
+
+void UHitboxWorldSubsystem::MarkParticipantDirty(FHitboxParticipant& Participant)
+{
+	Participant.WorldCache.Invalidate();
+	Participant.bGridDirty = true;
+	bSpatialIndexDirty = true;
+}
+
+bool UHitboxWorldSubsystem::SetParticipantRehitInterval(int32 ParticipantId, float Interval)
+{
+	FHitboxParticipant* Participant = FindParticipantMutable(ParticipantId);
+	if (!Participant) return false;
+
+	Participant->RehitInterval = FMath::Max(Interval, 0.0f);
+	return true;
+}
+
+bool UHitboxWorldSubsystem::BeginParticipantAttack(int32 ParticipantId)
+{
+	FHitboxParticipant* Participant = FindParticipantMutable(ParticipantId);
+	if (!Participant) return false;
+
+	Participant->AttackId = NextAttackId++;
+	Participant->AttackAnimationIndex = Participant->AnimationIndex;
+	Participant->HitDefenders.Reset();
+	return true;
+}
+
+int32 UHitboxWorldSubsystem::GetParticipantAttackId(int32 ParticipantId) const
+{
+	const FHitboxParticipant* Participant = FindParticipant(ParticipantId);
+	return Participant ? Participant->AttackId : INDEX_NONE;
+}
+
+bool UHitboxWorldSubsystem::SetParticipantTier(int32 ParticipantId, EHitboxProcessingTier Tier, bool bForce)
+{
+	FHitboxParticipant* Participant = FindParticipantMutable(ParticipantId);
+	if (!Participant) return false;
+
+	Participant->Tier = Tier;
+	Participant->bTierForced = bForce;
+	return true;
+}
+
+bool UHitboxWorldSubsystem::SetParticipantTierPhase(int32 ParticipantId, int32 Phase)
+{
+	FHitboxParticipant* Participant = FindParticipantMutable(ParticipantId);
+	if (!Participant) return false;
+
+	Participant->TierPhase = Phase;
+	return true;
+}
+
+EHitboxProcessingTier UHitboxWorldSubsystem::GetParticipantTier(int32 ParticipantId) const
+{
+	const FHitboxParticipant* Participant = FindParticipant(ParticipantId);
+	return Participant ? Participant->Tier : EHitboxProcessingTier::Full;
+}
+
+const FHitboxWorldCache* UHitboxWorldSubsystem::GetParticipantWorldBoxes(int32 ParticipantId)
+{
+	FHitboxParticipant* Participant = FindParticipantMutable(ParticipantId);
+	if (!Participant) return nullptr;
+
+	Participant->WorldCache.Update(Participant->GetFrame(), Participant->Position, Participant->bFlipX, Participant->Scale);
+	return &Participant->WorldCache;
+}
+
+bool UHitboxWorldSubsystem::CheckParticipantCollision(int32 AttackerId, int32 DefenderId, TArray<FHitboxCollisionResult>& OutResults)
+{
+	OutResults.Reset();
+
+	const FHitboxWorldCache* Attacker = GetParticipantWorldBoxes(AttackerId);
+	const FHitboxWorldCache* Defender = GetParticipantWorldBoxes(DefenderId);
+	if (!Attacker || !Defender) return false;
+
+	return UHitboxBlueprintLibrary::CheckCachedCollision(*Attacker, *Defender, OutResults);
+}
+
+const FHitboxParticipant* UHitboxWorldSubsystem::FindParticipantByOwner(const AActor* Owner) const
+{
+	if (!Owner) return nullptr;
+
+	return Participants.FindByPredicate([Owner](const FHitboxParticipant& Participant)
+	{
+		return Participant.Owner.Get() == Owner;
+	});
+}
+
+bool UHitboxWorldSubsystem::CanHit(const FHitboxParticipant& Attacker, const FHitboxParticipant& Defender) const
+{
+	if (Attacker.Id == Defender.Id || Attacker.Owner == Defender.Owner) return false;
+	return Attacker.Team == 0 || Attacker.Team != Defender.Team;
+}
+
+// ==========================================
+// COMPONENTS
+// ==========================================
+
+void UHitboxWorldSubsystem::AddManagedComponent(UHitboxComponent* Component)
+{
+	if (!Component || Component->ManagedIndex != INDEX_NONE) return;
+
+	const int32 Index = ManagedComponents.Add(Component);
+	const int32* ParticipantIndex = ParticipantIndices.Find(Component->ParticipantId);
+	ManagedStates.Add({ ParticipantIndex ? *ParticipantIndex : INDEX_NONE, Component->FlipbookState, false });
+	Component->ManagedIndex = Index;
+
+	if (ParticipantIndex)
+	{
+		Participants[*ParticipantIndex].ManagedIndex = Index;
+	}
+}
+
+void UHitboxWorldSubsystem::RemoveManagedComponent(UHitboxComponent* Component)
+{
+	if (!Component || !ManagedComponents.IsValidIndex(Component->ManagedIndex)) return;
+
+	const int32 Index = Component->ManagedIndex;
+	if (Participants.IsValidIndex(ManagedStates[Index].ParticipantIndex))
+	{
+		Participants[ManagedStates[Index].ParticipantIndex].ManagedIndex = INDEX_NONE;
+	}
+
+	ManagedComponents.RemoveAtSwap(Index);
+	ManagedStates.RemoveAtSwap(Index);
+	if (ManagedComponents.IsValidIndex(Index))
+	{
+		if (ManagedComponents[Index])
+		{
+			ManagedComponents[Index]->ManagedIndex = Index;
+		}
+		if (Participants.IsValidIndex(ManagedStates[Index].ParticipantIndex))
+		{
+			Participants[ManagedStates[Index].ParticipantIndex].ManagedIndex = Index;
+		}
+	}
+	Component->ManagedIndex = INDEX_NONE;
+}
+
+void UHitboxWorldSubsystem::UpdateManagedComponents()
+{
+	if (ManagedComponents.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitboxManagedUpdate);
+
+	FrameChangedComponents.Reset();
+	const int32 FrameChangedMax = FrameChangedComponents.Max();
+
+	// Resolve into the contiguous states and write participants by index; components are written only when their state changed
+	for (int32 Index = 0; Index < ManagedStates.Num(); ++Index)
+	{
+		FManagedState& State = ManagedStates[Index];
+		FHitboxParticipant* Participant = Participants.IsValidIndex(State.ParticipantIndex) ? &Participants[State.ParticipantIndex] : nullptr;
+		UHitboxComponent* Component = ManagedComponents[Index];
+		if (!Component || !Component->FlipbookComponent || !Component->HitboxData) continue;
+
+		bool bFrameChanged = false;
+		const bool bForceSync = State.bForceSync;
+		State.bForceSync = false;
+		if (!State.Flipbook.Update(*Component->FlipbookComponent, *Component->HitboxData, Component->bAutoFlipX, Component->bFlipX, bFrameChanged) && !bForceSync)
+		{
+			Component->FlipbookState.Depth = State.Flipbook.Depth;
+			continue;
+		}
+
+		Component->ApplyFlipbookState(State.Flipbook);
+
+		if (Participant)
+		{
+			Participant->AnimationIndex = State.Flipbook.AnimationIndex;
+			Participant->FrameIndex = State.Flipbook.FrameIndex;
+			Participant->Position = State.Flipbook.Position;
+			Participant->bFlipX = State.Flipbook.bFlipX;
+			Participant->Scale = State.Flipbook.Scale;
+			MarkParticipantDirty(*Participant);
+		}
+
+		if (bFrameChanged)
+		{
+			FrameChangedComponents.Add(Component);
+		}
+	}
+
+	CountScratchGrowth(FrameChangedMax, FrameChangedComponents.Max());
+
+	// Broadcast after the loop so handlers can safely add or remove components
+	for (int32 Index = 0; Index < FrameChangedComponents.Num(); ++Index)
+	{
+		if (UHitboxComponent* Changed = FrameChangedComponents[Index].Get())
+		{
+			Changed->OnHitboxFrameChanged.Broadcast(Changed, Changed->GetAnimationIndex(), Changed->GetFrameIndex());
+		}
+	}
+}
+
+// ==========================================
+// WORLD PROCESSING
+// ==========================================
+
+TStatId UHitboxWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitboxWorldSubsystem, STATGROUP_Tickables);
+}
+
+void UHitboxWorldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AdvanceSimulation(DeltaTime);
+
+	// Drawn from Tick only, so rollback resimulation and replays don't draw; a plain int test when off
+#if ENABLE_DRAW_DEBUG
+	if (GHitboxDebugDraw > 0)
+	{
+		DrawDebugState();
+	}
+#endif
+}
+
+void UHitboxWorldSubsystem::AdvanceSimulation(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxWorldTick);
+	CSV_SCOPED_TIMING_STAT(Hitbox, WorldTick);
+	SET_DWORD_STAT(STAT_HitboxParticipants, Participants.Num());
+	CSV_CUSTOM_STAT(Hitbox, Participants, Participants.Num(), ECsvCustomStatOp::Set);
+
+	SimulationTime += DeltaTime;
+	++TickCounter;
+	LODStats.AttackerPassesRun = 0;
+	LODStats.AttackerPassesSkipped = 0;
+
+	// Cleared every step so GetTickHits never reports an earlier tick, whatever runs below.
+	// Capacity from earlier ticks is kept, so a busy tick doesn't reallocate.
+	TickHits.Reset();
+	TickDefenders.Reset();
+
+	UpdateProcessingTiers();
+
+	UpdateManagedComponents();
+
+	// All inputs of this tick's collision work are final here
+	if (Capture)
+	{
+		Capture->WriteTick(DeltaTime, TickCounter, Participants);
+	}
+
+	if (bRecordHistory)
+	{
+		RecordHistory();
+	}
+
+	if (bEnableHitProcessing)
+	{
+		ProcessHits();
+	}
+
+#if ENABLE_VISUAL_LOG
+	if (CVarHitboxVisLog.GetValueOnGameThread() && FVisualLogger::IsRecording())
+	{
+		LogVisualState();
+	}
+#endif
+
+	SimulateProjectiles(DeltaTime);
+}
+
+void UHitboxWorldSubsystem::UpdateProcessingTiers()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::UpdateProcessingTiers);
+
+	LODStats.NumFull = 0;
+	LODStats.NumReduced = 0;
+	LODStats.NumDormant = 0;
+
+	TArray<FVector2D, TInlineAllocator<4>> Viewers;
+	UWorld* World = GetWorld();
+	if (bEnableProcessingLOD)
+	{
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			if (const APlayerController* Controller = It->Get())
+			{
+				FVector Location;
+				FRotator Rotation;
+				Controller->GetPlayerViewPoint(Location, Rotation);
+				Viewers.Add(FVector2D(Location.X, Location.Z));
+			}
+		}
+	}
+
+	const bool bCheckRendered = bReduceWhenNotRendered && World->GetNetMode() != NM_DedicatedServer;
+	const double ReducedDistanceSq = FMath::Square((double)ReducedDistance);
+	const double DormantDistanceSq = FMath::Square((double)DormantDistance);
+
+	for (FHitboxParticipant& Participant : Participants)
+	{
+		EHitboxProcessingTier Tier = EHitboxProcessingTier::Full;
+		if (Participant.bTierForced)
+		{
+			Tier = Participant.Tier;
+		}
+		else if (Viewers.Num() > 0)
+		{
+			double NearestSq = TNumericLimits<double>::Max();
+			for (const FVector2D& Viewer : Viewers)
+			{
+				NearestSq = FMath::Min(NearestSq, FVector2D::DistSquared(Viewer, Participant.Position));
+			}
+
+			if (NearestSq > DormantDistanceSq)
+			{
+				Tier = EHitboxProcessingTier::Dormant;
+			}
+			else if (NearestSq > ReducedDistanceSq)
+			{
+				Tier = EHitboxProcessingTier::Reduced;
+			}
+			else if (bCheckRendered)
+			{
+				const AActor* Owner = Participant.Owner.Get();
+				if (Owner && !Owner->WasRecentlyRendered(0.25f))
+				{
+					Tier = EHitboxProcessingTier::Reduced;
+				}
+			}
+		}
+
+		// Tiers only throttle the participant's own attacks, its hurtboxes stay in the grid as they are
+		Participant.Tier = Tier;
+
+		switch (Tier)
+		{
+		case EHitboxProcessingTier::Full:		LODStats.NumFull++; break;
+		case EHitboxProcessingTier::Reduced:	LODStats.NumReduced++; break;
+		case EHitboxProcessingTier::Dormant:	LODStats.NumDormant++; break;
+		}
+	}
+}
+
+bool UHitboxWorldSubsystem::IsTierDue(const FHitboxParticipant& Participant) const
+{
+	switch (Participant.Tier)
+	{
+	case EHitboxProcessingTier::Dormant:
+		return false;
+	case EHitboxProcessingTier::Reduced:
+		return (TickCounter + (uint32)Participant.TierPhase) % (uint32)FMath::Max(ReducedUpdateInterval, 1) == 0;
+	default:
+		return true;
+	}
+}
+
+void UHitboxWorldSubsystem::UpdateSpatialIndex()
+{
+	// A new cell size needs every item placed again, even in a still scene; otherwise only participants that changed are moved
+	const float CellSize = FMath::Max(CVarHitboxGridCellSize.GetValueOnGameThread(), 1.0f);
+	if (HurtboxGrid.GetCellSize() != CellSize)
+	{
+		ResetSpatialIndex(CellSize);
+	}
+	if (!bSpatialIndexDirty) return;
+	bSpatialIndexDirty = false;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitboxSpatialIndex);
+
+	for (int32 Index = 0; Index < Participants.Num(); ++Index)
+	{
+		FHitboxParticipant& Participant = Participants[Index];
+		if (!Participant.bGridDirty) continue;
+		Participant.bGridDirty = false;
+
+		RemoveFromSpatialIndex(Participant);
+
+		FHitboxWorldCache& Cache = Participant.WorldCache;
+		Cache.Update(Participant.GetFrame(), Participant.Position, Participant.bFlipX, Participant.Scale);
+		if (!Cache.HurtBounds.bIsValid) continue;
+
+		// Every tier keeps its exact hurtboxes, so hits on it, queries and projectiles don't depend on LOD
+		const TArray<FHitboxData>& Hitboxes = Cache.Frame->Hitboxes;
+		for (int32 HitboxIndex = 0; HitboxIndex < Hitboxes.Num(); ++HitboxIndex)
+		{
+			if (Hitboxes[HitboxIndex].Type != EHitboxType::Hurtbox) continue;
+
+			const int32 Item = HurtboxGrid.Insert(Cache.Boxes[HitboxIndex]);
+			if (Item >= HurtboxEntries.Num())
+			{
+				HurtboxEntries.SetNumUninitialized(Item + 1);
+			}
+			HurtboxEntries[Item] = { Index, &Hitboxes[HitboxIndex] };
+			Participant.GridItems.Add(Item);
+		}
+	}
+
+	LODStats.HurtboxesIndexed = HurtboxGrid.Num();
+}
+
+void UHitboxWorldSubsystem::RemoveFromSpatialIndex(FHitboxParticipant& Participant)
+{
+	for (const int32 Item : Participant.GridItems)
+	{
+		HurtboxGrid.Remove(Item);
+	}
+	Participant.GridItems.Reset();
+}
+
+void UHitboxWorldSubsystem::ResetSpatialIndex(float CellSize)
+{
+	HurtboxGrid.Reset(CellSize);
+	HurtboxEntries.Reset();
+	for (FHitboxParticipant& Participant : Participants)
+	{
+		Participant.GridItems.Reset();
+		Participant.bGridDirty = true;
+	}
+	bSpatialIndexDirty = true;
+}
+
+void UHitboxWorldSubsystem::QueryHurtboxes(const FBox2D& Box)
+{
+	QueryCandidates.Reset();
+	const int32 CandidatesMax = QueryCandidates.Max();
+	HurtboxGrid.Query(Box, QueryCandidates);
+	CountScratchGrowth(CandidatesMax, QueryCandidates.Max());
+	SortQueryCandidates();
+}
+
+void UHitboxWorldSubsystem::SortQueryCandidates()
+{
+	// Item indices are reused as participants move, so order by participant and hurtbox, the order a full rebuild inserts them in.
+	// Results then don't depend on which participants moved when.
+	if (QueryCandidates.Num() > 1)
+	{
+		Algo::Sort(QueryCandidates, [this](int32 A, int32 B)
+		{
+			const FHurtboxEntry& EntryA = HurtboxEntries[A];
+			const FHurtboxEntry& EntryB = HurtboxEntries[B];
+			return EntryA.ParticipantIndex != EntryB.ParticipantIndex ? EntryA.ParticipantIndex < EntryB.ParticipantIndex : EntryA.Hitbox < EntryB.Hitbox;
+		});
+	}
+}
+
+void UHitboxWorldSubsystem::UpdateAttackInstance(FHitboxParticipant& Attacker)
+{
+	const bool bActive = Attacker.WorldCache.AttackBounds.bIsValid;
+	if (bActive && (!Attacker.bAttackActive || Attacker.AttackAnimationIndex != Attacker.AnimationIndex))
+	{
+		Attacker.AttackId = NextAttackId++;
+		Attacker.AttackAnimationIndex = Attacker.AnimationIndex;
+		Attacker.HitDefenders.Reset();
+	}
+	Attacker.bAttackActive = bActive;
+}
+
+bool UHitboxWorldSubsystem::MarkBlockedDefenders(const FHitboxParticipant& Attacker, double Now)
+{
+	bool bAnyBlocked = false;
+	for (const FHitboxAttackHit& Hit : Attacker.HitDefenders)
+	{
+		if (Attacker.RehitInterval > 0.0f && Now - Hit.Time >= Attacker.RehitInterval) continue;
+
+		if (const int32* DefenderIndex = ParticipantIndices.Find(Hit.DefenderId))
+		{
+			BlockedDefenders[*DefenderIndex] = true;
+			bAnyBlocked = true;
+		}
+	}
+	return bAnyBlocked;
+}
+
+void UHitboxWorldSubsystem::QueryHurtboxes(const FBox2D& Box, const TBitArray<>& SkipParticipants)
+{
+	QueryCandidates.Reset();
+	const int32 CandidatesMax = QueryCandidates.Max();
+	HurtboxGrid.Query(Box, QueryCandidates, [this, &SkipParticipants](int32 Item)
+	{
+		return !SkipParticipants[HurtboxEntries[Item].ParticipantIndex];
+	});
+	CountScratchGrowth(CandidatesMax, QueryCandidates.Max());
+	SortQueryCandidates();
+}
+
+void UHitboxWorldSubsystem::ProcessHits()
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxProcessHits);
+	CSV_SCOPED_TIMING_STAT(Hitbox, ProcessHits);
+
+	UpdateSpatialIndex();
+	CSV_CUSTOM_STAT(Hitbox, Hurtboxes, HurtboxGrid.Num(), ECsvCustomStatOp::Set);
+
+	const bool bTrace = FHitboxTrace::IsEnabled();
+	if (bTrace && !bTraceWasEnabled)
+	{
+		// Assets registered while the channel was off were never sent
+		for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+		{
+			FHitboxTrace::OutputAsset(AssetIndex, Assets[AssetIndex]);
+		}
+	}
+	bTraceWasEnabled = bTrace;
+
+	if (bTrace)
+	{
+		FHitboxTrace::OutputTick(TickCounter, SimulationTime, Participants.Num(), HurtboxGrid.Num());
+		for (const FHitboxParticipant& Participant : Participants)
+		{
+			FHitboxTrace::OutputParticipant(Participant);
+		}
+	}
+
+	// Attack instances are tracked even without hurtboxes so active/inactive transitions aren't missed
+	const bool bHasHurtboxes = HurtboxGrid.Num() > 0;
+	if (!bHasHurtboxes && !bTrackAttackInstances)
+	{
+		// Written anyway so the CSV columns show an idle tick instead of the last busy one
+		CSV_CUSTOM_STAT(Hitbox, CandidatePairs, 0, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Hitbox, NarrowphaseTests, 0, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Hitbox, Hits, 0, ECsvCustomStatOp::Set);
+		return;
+	}
+
+	const double Now = SimulationTime;
+
+	const int32 TickHitsMax = TickHits.Max();
+	int32 CandidatePairs = 0;
+	const int64 FirstBoundsTest = HurtboxGrid.GetNumBoundsTests();
+
+	if (bTrackAttackInstances)
+	{
+		BlockedDefenders.Init(false, Participants.Num());
+	}
+
+	for (int32 AttackerIndex = 0; AttackerIndex < Participants.Num(); ++AttackerIndex)
+	{
+		FHitboxParticipant& Attacker = Participants[AttackerIndex];
+		const FHitboxWorldCache& Cache = Attacker.WorldCache;
+		if (!IsTierDue(Attacker))
+		{
+			LODStats.AttackerPassesSkipped++;
+			continue;
+		}
+
+		if (bTrackAttackInstances)
+		{
+			UpdateAttackInstance(Attacker);
+		}
+		if (!bHasHurtboxes || !Cache.AttackBounds.bIsValid || !Attacker.Owner.IsValid()) continue;
+
+		LODStats.AttackerPassesRun++;
+
+		// Reduced attackers test their aggregated attack bounds once instead of each attack box
+		const bool bAggregateAttacks = Attacker.Tier == EHitboxProcessingTier::Reduced;
+
+		// Defenders this attack instance already hit are filtered out by the grid before their bounds are tested
+		const bool bAnyBlocked = bTrackAttackInstances && MarkBlockedDefenders(Attacker, Now);
+
+		const int32 FirstHit = TickHits.Num();
+		const TArray<FHitboxData>& Hitboxes = Cache.Frame->Hitboxes;
+		for (int32 HitboxIndex = 0; HitboxIndex < Hitboxes.Num(); ++HitboxIndex)
+		{
+			const FHitboxData& Attack = Hitboxes[HitboxIndex];
+			if (Attack.Type != EHitboxType::Attack) continue;
+
+			const FBox2D& AttackWorld = bAggregateAttacks ? Cache.AttackBounds : Cache.Boxes[HitboxIndex];
+
+			if (bAnyBlocked)
+			{
+				QueryHurtboxes(AttackWorld, BlockedDefenders);
+			}
+			else
+			{
+				QueryHurtboxes(AttackWorld);
+			}
+			INC_DWORD_STAT_BY(STAT_HitboxPairsTested, QueryCandidates.Num());
+			CandidatePairs += QueryCandidates.Num();
+			if (bTrace)
+			{
+				FHitboxTrace::OutputAttack(Attacker.Id, Attacker.AttackId, HitboxIndex, QueryCandidates.Num());
+			}
+
+			for (const int32 Item : QueryCandidates)
+			{
+				const FHurtboxEntry& Hurt = HurtboxEntries[Item];
+				const FHitboxParticipant& Defender = Participants[Hurt.ParticipantIndex];
+				if (!CanHit(Attacker, Defender)) continue;
+
+				FHitboxHitEvent& Hit = TickHits.AddDefaulted_GetRef();
+				Hit.Attacker = Attacker.Owner.Get();
+				Hit.AttackerParticipantId = Attacker.Id;
+				Hit.Defender = Defender.Owner.Get();
+				Hit.DefenderParticipantId = Defender.Id;
+				Hit.AttackHitboxIndex = HitboxIndex;
+				Hit.HurtHitboxIndex = UE_PTRDIFF_TO_INT32(Hurt.Hitbox - Defender.WorldCache.Frame->Hitboxes.GetData());
+				Hit.Result = UHitboxBlueprintLibrary::MakeCollisionResult(Attack, AttackWorld, *Hurt.Hitbox, HurtboxGrid.GetItemBounds(Item));
+			}
+
+			if (bAggregateAttacks) break;
+		}
+
+		if (bAnyBlocked)
+		{
+			BlockedDefenders.SetRange(0, BlockedDefenders.Num(), false);
+		}
+
+		// Group by defender while keeping attack-major order, same as CheckHitboxCollision per pair
+		if (TickHits.Num() - FirstHit > 1)
+		{
+			Algo::StableSortBy(MakeArrayView(TickHits.GetData() + FirstHit, TickHits.Num() - FirstHit), &FHitboxHitEvent::DefenderParticipantId);
+		}
+
+		// Register after the attacker's pass so every box overlapping a defender this tick is still reported
+		if (bTrackAttackInstances)
+		{
+			for (int32 HitIndex = FirstHit; HitIndex < TickHits.Num(); ++HitIndex)
+			{
+				const int32 DefenderId = TickHits[HitIndex].DefenderParticipantId;
+				if (HitIndex > FirstHit && DefenderId == TickHits[HitIndex - 1].DefenderParticipantId) continue;
+
+				FHitboxAttackHit* Existing = Attacker.HitDefenders.FindByPredicate([DefenderId](const FHitboxAttackHit& Hit)
+				{
+					return Hit.DefenderId == DefenderId;
+				});
+
+				if (Existing)
+				{
+					Existing->Time = Now;
+				}
+				else
+				{
+					Attacker.HitDefenders.Add({ DefenderId, Now });
+				}
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_HitboxHits, TickHits.Num());
+	CSV_CUSTOM_STAT(Hitbox, CandidatePairs, CandidatePairs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Hitbox, NarrowphaseTests, (int32)(HurtboxGrid.GetNumBoundsTests() - FirstBoundsTest), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(Hitbox, Hits, TickHits.Num(), ECsvCustomStatOp::Set);
+	if (bTrace)
+	{
+		for (const FHitboxHitEvent& Hit : TickHits)
+		{
+			FHitboxTrace::OutputHit(Hit);
+		}
+	}
+	CountScratchGrowth(TickHitsMax, TickHits.Max());
+
+	// Broadcast after the pass so handlers can safely register, unregister or move participants
+	DispatchHits();
+}
+
+void UHitboxWorldSubsystem::DispatchHits()
+{
+	if (TickHits.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitboxDispatchHits);
+
+	if (HitDispatch == EHitboxHitDispatch::PerHit)
+	{
+		for (int32 HitIndex = 0; HitIndex < TickHits.Num(); ++HitIndex)
+		{
+			const FHitboxHitEvent& Hit = TickHits[HitIndex];
+			if (IsValid(Hit.Attacker) && IsValid(Hit.Defender))
+			{
+				OnHitboxHit.Broadcast(Hit.Attacker, Hit.Defender, Hit.Result);
+			}
+		}
+		return;
+	}
+
+	// Sorting keeps attacker order within a defender; summaries are built in the same pass
+	Algo::StableSortBy(TickHits, &FHitboxHitEvent::DefenderParticipantId);
+
+	for (int32 HitIndex = 0; HitIndex < TickHits.Num(); ++HitIndex)
+	{
+		const FHitboxHitEvent& Hit = TickHits[HitIndex];
+		if (TickDefenders.Num() == 0 || TickDefenders.Last().DefenderParticipantId != Hit.DefenderParticipantId)
+		{
+			FHitboxDefenderHits& Summary = TickDefenders.AddDefaulted_GetRef();
+			Summary.Defender = Hit.Defender;
+			Summary.DefenderParticipantId = Hit.DefenderParticipantId;
+			Summary.FirstHit = HitIndex;
+		}
+
+		FHitboxDefenderHits& Summary = TickDefenders.Last();
+		Summary.HitCount++;
+		Summary.TotalDamage += Hit.Result.Damage;
+		Summary.MaxKnockback = FMath::Max(Summary.MaxKnockback, Hit.Result.Knockback);
+	}
+
+	if (HitDispatch == EHitboxHitDispatch::PerTick)
+	{
+		OnHitboxTickHits.Broadcast(TickHits, TickDefenders);
+		return;
+	}
+
+	for (int32 DefenderIndex = 0; DefenderIndex < TickDefenders.Num(); ++DefenderIndex)
+	{
+		if (IsValid(TickDefenders[DefenderIndex].Defender))
+		{
+			OnHitboxDefenderHits.Broadcast(TickDefenders[DefenderIndex]);
+		}
+	}
+}
+
+bool UHitboxWorldSubsystem::GetDefenderTickHits(const FHitboxDefenderHits& DefenderHits, TArray<FHitboxHitEvent>& OutHits) const
+{
+	OutHits.Reset();
+
+	const int32 End = DefenderHits.FirstHit + DefenderHits.HitCount;
+	if (DefenderHits.HitCount <= 0 || DefenderHits.FirstHit < 0 || End > TickHits.Num()) return false;
+	if (TickHits[DefenderHits.FirstHit].DefenderParticipantId != DefenderHits.DefenderParticipantId) return false;
+
+	OutHits.Append(TickHits.GetData() + DefenderHits.FirstHit, DefenderHits.HitCount);
+	return true;
+}
+
+// ==========================================
+// VISUAL LOGGER
+// ==========================================
+
+#if ENABLE_VISUAL_LOG || ENABLE_DRAW_DEBUG
+template <typename VisitorType>
+void UHitboxWorldSubsystem::ForEachDebugParticipant(VisitorType&& Visitor)
+{
+	for (FHitboxParticipant& Participant : Participants)
+	{
+		const AActor* Owner = Participant.Owner.Get();
+		if (!Owner) continue;
+
+		// Caches are only fresh for processed participants; the grid is already marked dirty for stale ones
+		FHitboxWorldCache& Cache = Participant.WorldCache;
+		Cache.Update(Participant.GetFrame(), Participant.Position, Participant.bFlipX, Participant.Scale);
+
+		Visitor(Participant, *Owner, Cache, Owner->GetActorLocation().Y);
+	}
+}
+#endif
+
+#if ENABLE_VISUAL_LOG
+void UHitboxWorldSubsystem::LogVisualState()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::LogVisualState);
+
+	// Boxes are logged as thin slabs at the owner's depth (world Y)
+	auto ToWorldBox = [](const FBox2D& Box, double Depth)
+	{
+		return FBox(FVector(Box.Min.X, Depth - 1.0, Box.Min.Y), FVector(Box.Max.X, Depth + 1.0, Box.Max.Y));
+	};
+
+	const FColor SocketColor = UHitboxBlueprintLibrary::GetSocketColor().ToFColor(true);
+
+	ForEachDebugParticipant([&ToWorldBox, &SocketColor](const FHitboxParticipant& Participant, const AActor& Owner, const FHitboxWorldCache& Cache, double Depth)
+	{
+		UE_VLOG(&Owner, LogHitbox, Log, TEXT("Participant %d: animation %d frame %d, team %d, tier %d, attack %d%s"),
+			Participant.Id, Participant.AnimationIndex, Participant.FrameIndex, Participant.Team,
+			(int32)Participant.Tier, Participant.AttackId, Participant.bAttackActive ? TEXT(" (active)") : TEXT(""));
+
+		if (!Cache.Frame) return;
+
+		const TArray<FHitboxData>& Hitboxes = Cache.Frame->Hitboxes;
+		for (int32 Index = 0; Index < Hitboxes.Num(); ++Index)
+		{
+			UE_VLOG_BOX(&Owner, LogHitbox, Verbose, ToWorldBox(Cache.Boxes[Index], Depth),
+				UHitboxBlueprintLibrary::GetHitboxTypeColor(Hitboxes[Index].Type).ToFColor(true),
+				TEXT("%s %d"), *UHitboxBlueprintLibrary::HitboxTypeToString(Hitboxes[Index].Type), Index);
+		}
+
+		const TArray<FSocketData>& Sockets = Cache.Frame->Sockets;
+		for (int32 Index = 0; Index < Sockets.Num(); ++Index)
+		{
+			UE_VLOG_LOCATION(&Owner, LogHitbox, Verbose, FVector(Cache.Sockets[Index].X, Depth, Cache.Sockets[Index].Y), 4.0f, SocketColor, TEXT("%s"), *Sockets[Index].Name);
+		}
+	});
+
+	for (const FHitboxHitEvent& Hit : TickHits)
+	{
+		const AActor* Attacker = Hit.Attacker.Get();
+		const AActor* Defender = Hit.Defender.Get();
+		const double Depth = Defender ? Defender->GetActorLocation().Y : 0.0;
+		const FVector Location(Hit.Result.HitLocation.X, Depth, Hit.Result.HitLocation.Y);
+
+		UE_VLOG_LOCATION(Attacker, LogHitbox, Log, Location, 8.0f, FColor::White, TEXT("Hit %s: attack box %d -> hurtbox %d, %d damage, %d knockback"),
+			*GetNameSafe(Defender), Hit.AttackHitboxIndex, Hit.HurtHitboxIndex, Hit.Result.Damage, Hit.Result.Knockback);
+		UE_VLOG_LOCATION(Defender, LogHitbox, Log, Location, 8.0f, FColor::White, TEXT("Hit by %s: attack box %d -> hurtbox %d, %d damage, %d knockback"),
+			*GetNameSafe(Attacker), Hit.AttackHitboxIndex, Hit.HurtHitboxIndex, Hit.Result.Damage, Hit.Result.Knockback);
+	}
+}
+#endif
+
+// ==========================================
+// DEBUG DRAW
+// ==========================================
+
+#if ENABLE_DRAW_DEBUG
+void UHitboxWorldSubsystem::DrawDebugState()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::DrawDebugState);
+
+	UWorld* World = GetWorld();
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	ULineBatchComponent* LineBatcher = World ? ToRawPtr(World->LineBatcher) : nullptr;
+#else
+	ULineBatchComponent* LineBatcher = World ? World->GetLineBatcher(UWorld::ELineBatcherType::World) : nullptr;
+#endif
+	if (!LineBatcher) return;
+
+	TArray<FBatchedLine>& Lines = GHitboxDebugLines;
+	Lines.Reset();
+
+	// Boxes are drawn in the X/Z plane at the owner's depth (world Y), in front of the sprites
+	auto AddBox = [&Lines](const FBox2D& Box, double Depth, const FLinearColor& Color)
+	{
+		const FVector A(Box.Min.X, Depth, Box.Min.Y);
+		const FVector B(Box.Max.X, Depth, Box.Min.Y);
+		const FVector C(Box.Max.X, Depth, Box.Max.Y);
+		const FVector D(Box.Min.X, Depth, Box.Max.Y);
+		Lines.Emplace(A, B, Color, 0.0f, 1.0f, SDPG_Foreground);
+		Lines.Emplace(B, C, Color, 0.0f, 1.0f, SDPG_Foreground);
+		Lines.Emplace(C, D, Color, 0.0f, 1.0f, SDPG_Foreground);
+		Lines.Emplace(D, A, Color, 0.0f, 1.0f, SDPG_Foreground);
+	};
+
+	auto AddCross = [&Lines](const FVector2D& Point, double Depth, double Size, const FLinearColor& Color)
+	{
+		Lines.Emplace(FVector(Point.X - Size, Depth, Point.Y), FVector(Point.X + Size, Depth, Point.Y), Color, 0.0f, 1.0f, SDPG_Foreground);
+		Lines.Emplace(FVector(Point.X, Depth, Point.Y - Size), FVector(Point.X, Depth, Point.Y + Size), Color, 0.0f, 1.0f, SDPG_Foreground);
+	};
+
+	const FLinearColor SocketColor = UHitboxBlueprintLibrary::GetSocketColor();
+
+	ForEachDebugParticipant([&AddBox, &AddCross, &SocketColor](const FHitboxParticipant& Participant, const AActor& Owner, const FHitboxWorldCache& Cache, double Depth)
+	{
+		if (!Cache.Frame) return;
+
+		const TArray<FHitboxData>& Hitboxes = Cache.Frame->Hitboxes;
+		for (int32 Index = 0; Index < Hitboxes.Num(); ++Index)
+		{
+			AddBox(Cache.Boxes[Index], Depth, UHitboxBlueprintLibrary::GetHitboxTypeColor(Hitboxes[Index].Type));
+		}
+		for (const FVector2D& Socket : Cache.Sockets)
+		{
+			AddCross(Socket, Depth, 4.0, SocketColor);
+		}
+	});
+
+	if (GHitboxDebugDraw >= 2)
+	{
+		for (const FHitboxHitEvent& Hit : TickHits)
+		{
+			const AActor* Defender = Hit.Defender.Get();
+			AddCross(Hit.Result.HitLocation, Defender ? Defender->GetActorLocation().Y : 0.0, 8.0, FLinearColor::White);
+		}
+	}
+
+	if (Lines.Num() > 0)
+	{
+		LineBatcher->DrawLines(Lines);
+	}
+}
+#endif
+
+// ==========================================
+// LAG COMPENSATION
+// ==========================================
+
+void UHitboxWorldSubsystem::RecordHistory()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::RecordHistory);
+
+	// Simulation time, not world time, so rollback resimulation stamps records with the time being resimulated
+	const double Now = SimulationTime;
+	const int32 Capacity = FMath::Max(HistoryLength, 1);
+
+	for (FHitboxParticipant& Participant : Participants)
+	{
+		// HistoryLength changed: put the ring back in age order, then drop the oldest records if it shrank
+		TArray<FHitboxHistoryState>& History = Participant.History;
+		if (History.Num() > Capacity || (History.Num() < Capacity && Participant.HistoryHead != 0))
+		{
+			Algo::Rotate(History, Participant.HistoryHead);
+			if (History.Num() > Capacity)
+			{
+				History.RemoveAt(0, History.Num() - Capacity);
+			}
+			Participant.HistoryHead = 0;
+		}
+
+		FHitboxHistoryState State;
+		State.Time = Now;
+		State.AnimationIndex = Participant.AnimationIndex;
+		State.FrameIndex = Participant.FrameIndex;
+		State.Position = Participant.Position;
+		State.Scale = Participant.Scale;
+		State.bFlipX = Participant.bFlipX;
+
+		// Grow until full, then overwrite the oldest entry
+		if (History.Num() < Capacity)
+		{
+			History.Add(State);
+		}
+		else
+		{
+			History[Participant.HistoryHead] = State;
+			Participant.HistoryHead = (Participant.HistoryHead + 1) % History.Num();
+		}
+	}
+}
+
+bool UHitboxWorldSubsystem::GetRewoundState(const FHitboxParticipant& Participant, double Timestamp, bool bInterpolate, FHitboxHistoryState& OutState) const
+{
+	const int32 Num = Participant.History.Num();
+	const FHitboxHistoryState* Newer = nullptr;
+
+	// Walk from the newest record back to the first one at or before the timestamp
+	for (int32 Age = 0; Age < Num; ++Age)
+	{
+		const FHitboxHistoryState& Record = Participant.History[(Participant.HistoryHead - 1 - Age + Num) % Num];
+		if (Record.Time <= Timestamp)
+		{
+			OutState = Record;
+			if (bInterpolate && Newer && Newer->Time > Record.Time)
+			{
+				const double Alpha = (Timestamp - Record.Time) / (Newer->Time - Record.Time);
+				OutState.Time = Timestamp;
+				OutState.Position = FMath::Lerp(Record.Position, Newer->Position, Alpha);
+				OutState.Scale = FMath::Lerp(Record.Scale, Newer->Scale, (float)Alpha);
+			}
+			return true;
+		}
+		Newer = &Record;
+	}
+	return false;
+}
+
+bool UHitboxWorldSubsystem::GetParticipantStateAtTime(int32 ParticipantId, double Timestamp, bool bInterpolate, FHitboxHistoryState& OutState) const
+{
+	const FHitboxParticipant* Participant = FindParticipant(ParticipantId);
+	return Participant && GetRewoundState(*Participant, Timestamp, bInterpolate, OutState);
+}
+
+bool UHitboxWorldSubsystem::CheckRewoundCollision(int32 AttackerId, int32 DefenderId, double Timestamp, bool bInterpolate, TArray<FHitboxCollisionResult>& OutResults) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxQueries);
+
+	OutResults.Reset();
+
+	const FHitboxParticipant* Attacker = FindParticipant(AttackerId);
+	const FHitboxParticipant* Defender = FindParticipant(DefenderId);
+	if (!Attacker || !Defender || !Attacker->Asset || !Defender->Asset) return false;
+
+	FHitboxHistoryState AttackerState;
+	FHitboxHistoryState DefenderState;
+	if (!GetRewoundState(*Attacker, Timestamp, bInterpolate, AttackerState)) return false;
+	if (!GetRewoundState(*Defender, Timestamp, bInterpolate, DefenderState)) return false;
+
+	const FFrameHitboxData* AttackerFrame = Attacker->Asset->GetFramePtr(AttackerState.AnimationIndex, AttackerState.FrameIndex);
+	const FFrameHitboxData* DefenderFrame = Defender->Asset->GetFramePtr(DefenderState.AnimationIndex, DefenderState.FrameIndex);
+	if (!AttackerFrame || !DefenderFrame) return false;
+
+	return UHitboxBlueprintLibrary::CheckHitboxCollision(
+		*AttackerFrame, AttackerState.Position, AttackerState.bFlipX, AttackerState.Scale,
+		*DefenderFrame, DefenderState.Position, DefenderState.bFlipX, DefenderState.Scale,
+		OutResults
+	);
+}
+
+bool UHitboxWorldSubsystem::RewoundOverlapBox(const FBox2D& Box, double Timestamp, const FHitboxQueryFilter& Filter, bool bInterpolate, TArray<FHitboxOverlapResult>& OutHits) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxQueries);
+
+	OutHits.Reset();
+
+	// The grid only holds current boxes, so historical states are tested directly
+	for (const FHitboxParticipant& Participant : Participants)
+	{
+		if (!Participant.Asset || !PassesFilter(Filter, Participant)) continue;
+
+		FHitboxHistoryState State;
+		if (!GetRewoundState(Participant, Timestamp, bInterpolate, State)) continue;
+
+		const FFrameHitboxData* Frame = Participant.Asset->GetFramePtr(State.AnimationIndex, State.FrameIndex);
+		if (!Frame) continue;
+
+		for (const FHitboxData& Hitbox : Frame->Hitboxes)
+		{
+			if (Hitbox.Type != EHitboxType::Hurtbox) continue;
+
+			const FBox2D HurtWorld = UHitboxBlueprintLibrary::HitboxToWorldSpace(Hitbox, State.Position, State.bFlipX, State.Scale);
+			if (!Box.Intersect(HurtWorld)) continue;
+
+			FHitboxOverlapResult& Hit = OutHits.AddDefaulted_GetRef();
+			Hit.Actor = Participant.Owner.Get();
+			Hit.ParticipantId = Participant.Id;
+			Hit.Hurtbox = Hitbox;
+			Hit.HurtboxWorld = HurtWorld;
+			Hit.HitLocation = FBox2D(
+				FVector2D(FMath::Max(Box.Min.X, HurtWorld.Min.X), FMath::Max(Box.Min.Y, HurtWorld.Min.Y)),
+				FVector2D(FMath::Min(Box.Max.X, HurtWorld.Max.X), FMath::Min(Box.Max.Y, HurtWorld.Max.Y))
+			).GetCenter();
+
+			if (Filter.bOnePerActor) break;
+		}
+	}
+
+	return OutHits.Num() > 0;
+}
+
+// ==========================================
+// REPLICATION
+// ==========================================
+
+FHitboxReplicatedState UHitboxWorldSubsystem::GetParticipantReplicatedState(int32 ParticipantId) const
+{
+	FHitboxReplicatedState State;
+	if (const FHitboxParticipant* Participant = FindParticipant(ParticipantId))
+	{
+		State.Position = Participant->Position;
+		State.AnimationIndex = Participant->AnimationIndex;
+		State.FrameIndex = Participant->FrameIndex;
+		State.Scale = Participant->Scale;
+		State.bFlipX = Participant->bFlipX;
+	}
+	return State;
+}
+
+bool UHitboxWorldSubsystem::ApplyReplicatedState(int32 ParticipantId, const FHitboxReplicatedState& State)
+{
+	if (!SetParticipantTransform(ParticipantId, State.Position, State.bFlipX, State.Scale)) return false;
+
+	SetParticipantFrame(ParticipantId, State.AnimationIndex, State.FrameIndex);
+	return true;
+}
+
+FHitboxReplicatedHit UHitboxWorldSubsystem::MakeReplicatedHit(const FHitboxHitEvent& Hit) const
+{
+	FHitboxReplicatedHit Replicated;
+	Replicated.Attacker = Hit.Attacker;
+	Replicated.Defender = Hit.Defender;
+	Replicated.AttackHitboxIndex = Hit.AttackHitboxIndex;
+	Replicated.HurtHitboxIndex = Hit.HurtHitboxIndex;
+
+	// Hits are made in the tick they were found, so the participants are still on the frames that produced them
+	if (const FHitboxParticipant* Attacker = FindParticipant(Hit.AttackerParticipantId))
+	{
+		Replicated.AttackerAnimationIndex = Attacker->AnimationIndex;
+		Replicated.AttackerFrameIndex = Attacker->FrameIndex;
+	}
+	if (const FHitboxParticipant* Defender = FindParticipant(Hit.DefenderParticipantId))
+	{
+		Replicated.DefenderAnimationIndex = Defender->AnimationIndex;
+		Replicated.DefenderFrameIndex = Defender->FrameIndex;
+		Replicated.HitOffset = Hit.Result.HitLocation - Defender->Position;
+	}
+	return Replicated;
+}
+
+bool UHitboxWorldSubsystem::ResolveReplicatedHit(const FHitboxReplicatedHit& Hit, FHitboxCollisionResult& OutResult) const
+{
+	OutResult = FHitboxCollisionResult();
+
+	const FHitboxParticipant* Attacker = FindParticipantByOwner(Hit.Attacker);
+	const FHitboxParticipant* Defender = FindParticipantByOwner(Hit.Defender);
+	if (!Attacker || !Defender) return false;
+
+	// The sender's frames, not the local ones, which may already have moved on or not caught up yet
+	const FFrameHitboxData* AttackerFrame = Attacker->Asset ? Attacker->Asset->GetFramePtr(Hit.AttackerAnimationIndex, Hit.AttackerFrameIndex) : nullptr;
+	const FFrameHitboxData* DefenderFrame = Defender->Asset ? Defender->Asset->GetFramePtr(Hit.DefenderAnimationIndex, Hit.DefenderFrameIndex) : nullptr;
+	if (!AttackerFrame || !AttackerFrame->Hitboxes.IsValidIndex(Hit.AttackHitboxIndex)) return false;
+	if (!DefenderFrame || !DefenderFrame->Hitboxes.IsValidIndex(Hit.HurtHitboxIndex)) return false;
+
+	const FHitboxData& Attack = AttackerFrame->Hitboxes[Hit.AttackHitboxIndex];
+	OutResult.bHit = true;
+	OutResult.AttackHitbox = Attack;
+	OutResult.HurtHitbox = DefenderFrame->Hitboxes[Hit.HurtHitboxIndex];
+	OutResult.HitLocation = Defender->Position + Hit.HitOffset;
+	OutResult.Damage = Attack.Damage;
+	OutResult.Knockback = Attack.Knockback;
+	return true;
+}
+
+// ==========================================
+// ROLLBACK
+// ==========================================
+
+void UHitboxWorldSubsystem::SaveState(FHitboxWorldSnapshot& OutSnapshot) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::SaveState);
+
+	OutSnapshot.Participants.Reset();
+	OutSnapshot.Hits.Reset();
+	OutSnapshot.Participants.Reserve(Participants.Num());
+
+	for (const FHitboxParticipant& Participant : Participants)
+	{
+		FHitboxParticipantState& State = OutSnapshot.Participants.AddUninitialized_GetRef();
+		State.Owner = Participant.Owner;
+		State.Id = Participant.Id;
+		State.AssetIndex = Participant.AssetIndex;
+		State.AnimationIndex = Participant.AnimationIndex;
+		State.FrameIndex = Participant.FrameIndex;
+		State.Position = Participant.Position;
+		State.Scale = Participant.Scale;
+		State.Team = Participant.Team;
+		State.AttackId = Participant.AttackId;
+		State.AttackAnimationIndex = Participant.AttackAnimationIndex;
+		State.RehitInterval = Participant.RehitInterval;
+		State.TierPhase = Participant.TierPhase;
+		State.FirstHit = OutSnapshot.Hits.Num();
+		State.NumHits = Participant.HitDefenders.Num();
+		State.Tier = Participant.Tier;
+		State.bFlipX = Participant.bFlipX;
+		State.bAttackActive = Participant.bAttackActive;
+		State.bTierForced = Participant.bTierForced;
+
+		OutSnapshot.Hits.Append(Participant.HitDefenders);
+	}
+
+	OutSnapshot.Projectiles = Projectiles;
+	OutSnapshot.SimulationTime = SimulationTime;
+	OutSnapshot.TickCounter = TickCounter;
+	OutSnapshot.NextParticipantId = NextParticipantId;
+	OutSnapshot.NextAttackId = NextAttackId;
+	OutSnapshot.NextProjectileId = NextProjectileId;
+}
+
+void UHitboxWorldSubsystem::LoadState(const FHitboxWorldSnapshot& Snapshot)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Hitbox::LoadState);
+
+	// Keep the existing elements (and their hit registry and cache allocations) where possible
+	Participants.SetNum(Snapshot.Participants.Num());
+	ParticipantIndices.Reset();
+
+	for (int32 Index = 0; Index < Snapshot.Participants.Num(); ++Index)
+	{
+		const FHitboxParticipantState& State = Snapshot.Participants[Index];
+		FHitboxParticipant& Participant = Participants[Index];
+		Participant.Owner = State.Owner;
+		Participant.Id = State.Id;
+		Participant.AssetIndex = State.AssetIndex;
+		Participant.Asset = Assets.IsValidIndex(State.AssetIndex) ? Assets[State.AssetIndex] : nullptr;
+		Participant.AnimationIndex = State.AnimationIndex;
+		Participant.FrameIndex = State.FrameIndex;
+		Participant.Position = State.Position;
+		Participant.Scale = State.Scale;
+		Participant.Team = State.Team;
+		Participant.AttackId = State.AttackId;
+		Participant.AttackAnimationIndex = State.AttackAnimationIndex;
+		Participant.RehitInterval = State.RehitInterval;
+		Participant.TierPhase = State.TierPhase;
+		Participant.Tier = State.Tier;
+		Participant.bFlipX = State.bFlipX;
+		Participant.bAttackActive = State.bAttackActive;
+		Participant.bTierForced = State.bTierForced;
+		Participant.HitDefenders.Reset();
+		Participant.HitDefenders.Append(Snapshot.Hits.GetData() + State.FirstHit, State.NumHits);
+		Participant.WorldCache.Invalidate();
+
+		// Records after the snapshot belong to the discarded timeline, and a reused slot may hold another participant's
+		Participant.History.Reset();
+		Participant.HistoryHead = 0;
+
+		Participant.ManagedIndex = INDEX_NONE;
+		ParticipantIndices.Add(State.Id, Index);
+	}
+
+	// Participants moved between slots, link batched components to theirs again
+	for (int32 Index = 0; Index < ManagedStates.Num(); ++Index)
+	{
+		const int32* ParticipantIndex = ManagedComponents[Index] ? ParticipantIndices.Find(ManagedComponents[Index]->ParticipantId) : nullptr;
+		ManagedStates[Index].ParticipantIndex = ParticipantIndex ? *ParticipantIndex : INDEX_NONE;
+
+		// The restored participant no longer matches what the component last read
+		ManagedStates[Index].bForceSync = true;
+		if (ParticipantIndex)
+		{
+			Participants[*ParticipantIndex].ManagedIndex = Index;
+		}
+	}
+
+	Projectiles = Snapshot.Projectiles;
+	SimulationTime = Snapshot.SimulationTime;
+	TickCounter = Snapshot.TickCounter;
+	NextParticipantId = FMath::Max(NextParticipantId, Snapshot.NextParticipantId);
+	NextAttackId = Snapshot.NextAttackId;
+	NextProjectileId = Snapshot.NextProjectileId;
+
+	// Slots now hold other participants, so the grid is rebuilt from scratch
+	ResetSpatialIndex(HurtboxGrid.GetCellSize());
+}
+
+// ==========================================
+// CAPTURE
+// ==========================================
+
+bool UHitboxWorldSubsystem::StartCapture(const FString& Filename)
+{
+	StopCapture();
+
+	TUniquePtr<FHitboxCaptureWriter> Writer = MakeUnique<FHitboxCaptureWriter>();
+	if (!Writer->Open(Filename, HitDispatch, bTrackAttackInstances, ReducedUpdateInterval)) return false;
+
+	Capture = MoveTemp(Writer);
+	return true;
+}
+
+void UHitboxWorldSubsystem::StopCapture()
+{
+	if (!Capture) return;
+
+	UE_LOG(LogTemp, Log, TEXT("HitboxCapture: wrote %d ticks (%lld bytes) to %s"), Capture->GetNumTicks(), Capture->GetNumBytes(), *Capture->GetFilename());
+	Capture->Close();
+	Capture.Reset();
+}
+
+void UHitboxWorldSubsystem::Deinitialize()
+{
+	StopCapture();
+
+	Super::Deinitialize();
+}
+
+// ==========================================
+// QUERIES
+// ==========================================
+
+bool UHitboxWorldSubsystem::OverlapBox(const FBox2D& Box, const FHitboxQueryFilter& Filter, TArray<FHitboxOverlapResult>& OutHits)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxQueries);
+
+	OutHits.Reset();
+
+	UpdateSpatialIndex();
+	if (HurtboxGrid.Num() == 0) return false;
+
+	QueryHurtboxes(Box);
+
+	int32 LastReportedParticipant = INDEX_NONE;
+	for (const int32 Item : QueryCandidates)
+	{
+		const FHurtboxEntry& Hurt = HurtboxEntries[Item];
+		const FHitboxParticipant& Participant = Participants[Hurt.ParticipantIndex];
+
+		// Candidates are sorted by participant, so one participant's hurtboxes are contiguous
+		if (Filter.bOnePerActor && Hurt.ParticipantIndex == LastReportedParticipant) continue;
+		if (!PassesFilter(Filter, Participant)) continue;
+
+		AActor* Actor = Participant.Owner.Get();
+
+		const FBox2D& HurtWorld = HurtboxGrid.GetItemBounds(Item);
+
+		FHitboxOverlapResult& Hit = OutHits.AddDefaulted_GetRef();
+		Hit.Actor = Actor;
+		Hit.ParticipantId = Participant.Id;
+		Hit.Hurtbox = *Hurt.Hitbox;
+		Hit.HurtboxWorld = HurtWorld;
+		Hit.HitLocation = FBox2D(
+			FVector2D(FMath::Max(Box.Min.X, HurtWorld.Min.X), FMath::Max(Box.Min.Y, HurtWorld.Min.Y)),
+			FVector2D(FMath::Min(Box.Max.X, HurtWorld.Max.X), FMath::Min(Box.Max.Y, HurtWorld.Max.Y))
+		).GetCenter();
+
+		LastReportedParticipant = Hurt.ParticipantIndex;
+	}
+
+	return OutHits.Num() > 0;
+}
+
+bool UHitboxWorldSubsystem::RaycastHurtboxes(FVector2D Start, FVector2D End, const FHitboxQueryFilter& Filter, FHitboxRaycastResult& OutHit)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxQueries);
+
+	OutHit = FHitboxRaycastResult();
+
+	UpdateSpatialIndex();
+	if (HurtboxGrid.Num() == 0) return false;
+
+	QueryHurtboxes(FBox2D(FVector2D::Min(Start, End), FVector2D::Max(Start, End)));
+
+	// Gather accepted candidates contiguously for the batched slab test
+	TArray<FBox2D, TInlineAllocator<32>> Boxes;
+	TArray<int32, TInlineAllocator<32>> Items;
+	for (const int32 Item : QueryCandidates)
+	{
+		if (!PassesFilter(Filter, Participants[HurtboxEntries[Item].ParticipantIndex])) continue;
+
+		Boxes.Add(HurtboxGrid.GetItemBounds(Item));
+		Items.Add(Item);
+	}
+
+	float Time = 1.0f;
+	FVector2D Normal = FVector2D::ZeroVector;
+	const int32 BoxIndex = UHitboxBlueprintLibrary::RaycastBoxes(Boxes, Start, End, Time, Normal);
+	if (BoxIndex == INDEX_NONE) return false;
+
+	const FHurtboxEntry& Hurt = HurtboxEntries[Items[BoxIndex]];
+	const FHitboxParticipant& Participant = Participants[Hurt.ParticipantIndex];
+
+	OutHit.bHit = true;
+	OutHit.Actor = Participant.Owner.Get();
+	OutHit.ParticipantId = Participant.Id;
+	OutHit.Hitbox = *Hurt.Hitbox;
+	OutHit.Time = Time;
+	OutHit.Location = Start + (End - Start) * Time;
+	OutHit.Normal = Normal;
+	OutHit.Distance = (End - Start).Size() * Time;
+	return true;
+}
+
+bool UHitboxWorldSubsystem::PassesFilter(const FHitboxQueryFilter& Filter, const FHitboxParticipant& Participant) const
+{
+	if (Filter.Team != 0 && Filter.Team == Participant.Team) return false;
+
+	AActor* Actor = Participant.Owner.Get();
+	return Actor && !Filter.IgnoredActors.Contains(Actor);
+}
+
+// ==========================================
+// PROJECTILES
+// ==========================================
+
+int32 UHitboxWorldSubsystem::SpawnProjectile(FVector2D Position, const FHitboxProjectileParams& Params, bool bFlipX, int32 Team, AActor* Instigator)
+{
+	FHitboxProjectile& Projectile = Projectiles.AddDefaulted_GetRef();
+	Projectile.Id = NextProjectileId++;
+	Projectile.Position = Position;
+	Projectile.Velocity = FVector2D(bFlipX ? -Params.Velocity.X : Params.Velocity.X, Params.Velocity.Y);
+	Projectile.HalfExtents = Params.HalfExtents;
+	Projectile.RemainingLifetime = Params.Lifetime;
+	Projectile.Damage = Params.Damage;
+	Projectile.Knockback = Params.Knockback;
+	Projectile.Team = Team;
+	Projectile.Instigator = Instigator;
+
+	return Projectile.Id;
+}
+
+int32 UHitboxWorldSubsystem::SpawnProjectileFromSocket(const FSocketData& Socket, FVector2D WorldPosition, bool bFlipX, float Scale, const FHitboxProjectileParams& Params, int32 Team, AActor* Instigator)
+{
+	return SpawnProjectile(UHitboxBlueprintLibrary::SocketToWorldSpace(Socket, WorldPosition, bFlipX, Scale), Params, bFlipX, Team, Instigator);
+}
+
+int32 UHitboxWorldSubsystem::SpawnProjectileFromParticipantSocket(int32 ParticipantId, const FString& SocketName, const FHitboxProjectileParams& Params)
+{
+	const FHitboxWorldCache* Cache = GetParticipantWorldBoxes(ParticipantId);
+	FVector2D SocketPosition;
+	if (!Cache || !Cache->FindSocket(SocketName, SocketPosition)) return INDEX_NONE;
+
+	const FHitboxParticipant* Participant = FindParticipant(ParticipantId);
+	return SpawnProjectile(SocketPosition, Params, Participant->bFlipX, Participant->Team, Participant->Owner.Get());
+}
+
+void UHitboxWorldSubsystem::SimulateProjectiles(float DeltaTime)
+{
+	if (Projectiles.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_HitboxProjectiles);
+
+	UpdateSpatialIndex();
+
+	TArray<FHitboxProjectileHit> Hits;
+	TArray<FBox2D, TInlineAllocator<32>> ExpandedBoxes;
+	TArray<int32, TInlineAllocator<32>> Items;
+
+	// Reverse order so expired projectiles can be swapped out in place
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; --Index)
+	{
+		FHitboxProjectile& Projectile = Projectiles[Index];
+		const FVector2D Start = Projectile.Position;
+		const FVector2D End = Start + Projectile.Velocity * DeltaTime;
+
+		Projectile.Position = End;
+		Projectile.RemainingLifetime -= DeltaTime;
+		bool bRemove = Projectile.RemainingLifetime <= 0.0f;
+
+		if (HurtboxGrid.Num() > 0)
+		{
+			// Sweep the whole move so fast projectiles can't tunnel through thin hurtboxes
+			const FBox2D Swept(FVector2D::Min(Start, End) - Projectile.HalfExtents, FVector2D::Max(Start, End) + Projectile.HalfExtents);
+
+			QueryHurtboxes(Swept);
+
+			// Hurtboxes grown by the projectile size turn the box sweep into a segment cast of its center
+			ExpandedBoxes.Reset();
+			Items.Reset();
+			for (const int32 Item : QueryCandidates)
+			{
+				const FHitboxParticipant& Participant = Participants[HurtboxEntries[Item].ParticipantIndex];
+				if (Projectile.Team != 0 && Projectile.Team == Participant.Team) continue;
+				if (!Participant.Owner.IsValid() || Participant.Owner == Projectile.Instigator) continue;
+
+				const FBox2D& Bounds = HurtboxGrid.GetItemBounds(Item);
+				ExpandedBoxes.Add(FBox2D(Bounds.Min - Projectile.HalfExtents, Bounds.Max + Projectile.HalfExtents));
+				Items.Add(Item);
+			}
+
+			float Time = 1.0f;
+			FVector2D Normal = FVector2D::ZeroVector;
+			const int32 BoxIndex = UHitboxBlueprintLibrary::RaycastBoxes(ExpandedBoxes, Start, End, Time, Normal);
+			if (BoxIndex != INDEX_NONE)
+			{
+				const FHurtboxEntry& Hurt = HurtboxEntries[Items[BoxIndex]];
+				const FHitboxParticipant& Participant = Participants[Hurt.ParticipantIndex];
+
+				FHitboxProjectileHit& Hit = Hits.AddDefaulted_GetRef();
+				Hit.ProjectileId = Projectile.Id;
+				Hit.Instigator = Projectile.Instigator.Get();
+				Hit.Defender = Participant.Owner.Get();
+				Hit.DefenderParticipantId = Participant.Id;
+				Hit.HurtHitbox = *Hurt.Hitbox;
+				Hit.HitLocation = Start + (End - Start) * Time;
+				Hit.Damage = Projectile.Damage;
+				Hit.Knockback = Projectile.Knockback;
+				bRemove = true;
+			}
+		}
+
+		if (bRemove)
+		{
+			Projectiles.RemoveAtSwap(Index);
+		}
+	}
+
+	for (const FHitboxProjectileHit& Hit : Hits)
+	{
+		OnProjectileHit.Broadcast(Hit);
+	}
+}
+
+// ==========================================
+// PUSH BOXES
+// ==========================================
+
+bool UHitboxWorldSubsystem::ResolvePushBoxes(TArray<FHitboxPushCorrection>& OutCorrections, int32 Iterations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitboxQueries);
+
+	OutCorrections.Reset();
+
+	UpdateSpatialIndex();
+
+	// A body is one participant's set of collision boxes
+	struct FPushBody
+	{
+		int32 ParticipantIndex;
+		int32 FirstBox;
+		int32 NumBoxes;
+		FBox2D LocalBounds;
+		FVector2D Position;
+		FVector2D Delta;
+	};
+
+	// Collision boxes relative to the participant position, taken from the world box caches.
+	// Only positions change between iterations, so boxes are gathered once.
+	TArray<FPushBody> Bodies;
+	TArray<FBox2D> LocalBoxes;
+	Bodies.Reserve(Participants.Num());
+
+	for (int32 Index = 0; Index < Participants.Num(); ++Index)
+	{
+		const FHitboxParticipant& Participant = Participants[Index];
+		const FHitboxWorldCache& Cache = Participant.WorldCache;
+		if (!Cache.Frame || !Participant.Owner.IsValid()) continue;
+
+		const int32 FirstBox = LocalBoxes.Num();
+		FBox2D Bounds(ForceInit);
+		for (int32 HitboxIndex = 0; HitboxIndex < Cache.Frame->Hitboxes.Num(); ++HitboxIndex)
+		{
+			if (Cache.Frame->Hitboxes[HitboxIndex].Type != EHitboxType::Collision) continue;
+
+			const FBox2D Local = Cache.Boxes[HitboxIndex].ShiftBy(-Participant.Position);
+			LocalBoxes.Add(Local);
+			Bounds += Local;
+		}
+
+		if (LocalBoxes.Num() > FirstBox)
+		{
+			Bodies.Add({ Index, FirstBox, LocalBoxes.Num() - FirstBox, Bounds, Participant.Position, FVector2D::ZeroVector });
+		}
+	}
+
+	if (Bodies.Num() < 2) return false;
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Bodies.Num());
+
+	const int32 NumIterations = FMath::Max(Iterations, 1);
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		// Sort and sweep along X so only bodies whose bounds overlap horizontally are compared
+		for (int32 Index = 0; Index < Order.Num(); ++Index)
+		{
+			Order[Index] = Index;
+		}
+		Order.Sort([&Bodies](int32 A, int32 B)
+		{
+			return Bodies[A].LocalBounds.Min.X + Bodies[A].Position.X < Bodies[B].LocalBounds.Min.X + Bodies[B].Position.X;
+		});
+
+		bool bAnyOverlap = false;
+		for (int32 OrderA = 0; OrderA < Order.Num(); ++OrderA)
+		{
+			FPushBody& BodyA = Bodies[Order[OrderA]];
+			const FBox2D BoundsA = BodyA.LocalBounds.ShiftBy(BodyA.Position);
+
+			for (int32 OrderB = OrderA + 1; OrderB < Order.Num(); ++OrderB)
+			{
+				FPushBody& BodyB = Bodies[Order[OrderB]];
+				const FBox2D BoundsB = BodyB.LocalBounds.ShiftBy(BodyB.Position);
+				if (BoundsB.Min.X >= BoundsA.Max.X) break;
+				if (BoundsB.Min.Y >= BoundsA.Max.Y || BoundsA.Min.Y >= BoundsB.Max.Y) continue;
+
+				// Deepest box pair decides how far the bodies must separate
+				FVector2D Separation = FVector2D::ZeroVector;
+				for (int32 BoxA = BodyA.FirstBox; BoxA < BodyA.FirstBox + BodyA.NumBoxes; ++BoxA)
+				{
+					const FBox2D WorldA = LocalBoxes[BoxA].ShiftBy(BodyA.Position);
+					for (int32 BoxB = BodyB.FirstBox; BoxB < BodyB.FirstBox + BodyB.NumBoxes; ++BoxB)
+					{
+						const FVector2D Candidate = UHitboxBlueprintLibrary::GetBoxSeparation(WorldA, LocalBoxes[BoxB].ShiftBy(BodyB.Position));
+						if (Candidate.SizeSquared() > Separation.SizeSquared())
+						{
+							Separation = Candidate;
+						}
+					}
+				}
+
+				if (!Separation.IsZero())
+				{
+					BodyA.Delta += Separation * 0.5;
+					BodyB.Delta -= Separation * 0.5;
+					bAnyOverlap = true;
+				}
+			}
+		}
+
+		if (!bAnyOverlap) break;
+
+		// Apply all deltas after the pass so results do not depend on pair order
+		for (FPushBody& Body : Bodies)
+		{
+			Body.Position += Body.Delta;
+			Body.Delta = FVector2D::ZeroVector;
+		}
+	}
+
+	for (const FPushBody& Body : Bodies)
+	{
+		const FHitboxParticipant& Participant = Participants[Body.ParticipantIndex];
+		const FVector2D Correction = Body.Position - Participant.Position;
+		if (Correction.IsNearlyZero()) continue;
+
+		FHitboxPushCorrection& Result = OutCorrections.AddDefaulted_GetRef();
+		Result.Actor = Participant.Owner.Get();
+		Result.ParticipantId = Participant.Id;
+		Result.Correction = Correction;
+	}
+
+	return OutCorrections.Num() > 0;
+}
@@ -6,6 +6,8 @@
 #include "HitboxDataAsset.h"
 #include "HitboxBlueprintLibrary.generated.h"
 
+struct FHitboxWorldCache;
+
 /**
  * Blueprint function library for hitbox operations.
  * Provides world-space conversion, collision detection, and utility functions.
@@ -77,6 +79,15 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Hitbox|Collision")
 	static bool DoBoxesOverlap(const FBox2D& BoxA, const FBox2D& BoxB);
 
+	/**
+	 * Get the minimum translation that pushes BoxA out of BoxB
+	 * @param BoxA Box to move
+	 * @param BoxB Box to separate from
+	 * @return Offset along the axis of least penetration, zero if not overlapping
+	 */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Collision")
+	static FVector2D GetBoxSeparation(const FBox2D& BoxA, const FBox2D& BoxB);
+
 	/**
 	 * Check collision between attacker and defender hitboxes (single frame)
 	 * Checks all attack hitboxes against all hurtboxes
@@ -120,6 +131,21 @@ public:
 		TArray<FHitboxCollisionResult>& OutResults
 	);
 
+	/** Build the result for an attack box overlapping a hurtbox (both already in world space) */
+	static FHitboxCollisionResult MakeCollisionResult(const FHitboxData& Attack, const FBox2D& AttackWorld, const FHitboxData& Hurt, const FBox2D& HurtWorld);
+
+	/**
+	 * Same as CheckHitboxCollision, using boxes already placed in world space (no per-call transforms)
+	 * @param Attacker Attacker's cached world boxes
+	 * @param Defender Defender's cached world boxes
+	 * @param OutResults Array of collision results (one per hit)
+	 * @return True if any collision occurred
+	 */
+	static bool CheckCachedCollision(const FHitboxWorldCache& Attacker, const FHitboxWorldCache& Defender, TArray<FHitboxCollisionResult>& OutResults);
+
+	/** Same as QuickHitCheck, using boxes already placed in world space */
+	static bool QuickCachedHitCheck(const FHitboxWorldCache& Attacker, const FHitboxWorldCache& Defender);
+
 	/**
 	 * Quick check if any attack hitbox overlaps any hurtbox (no detailed results)
 	 * Faster than full collision check when you only need a boolean
@@ -136,6 +162,45 @@ public:
 		float DefenderScale
 	);
 
+	// ==========================================
+	// RAYCASTS
+	// ==========================================
+
+	/**
+	 * Find the first hitbox of a type along a segment (e.g. hitscan against a defender's hurtboxes)
+	 * @param FrameData Frame to test
+	 * @param WorldPosition Frame owner's world position
+	 * @param bFlipX Is the frame owner facing left
+	 * @param Scale Frame owner's scale
+	 * @param Start Segment start (world space)
+	 * @param End Segment end (world space)
+	 * @param Type Which hitboxes to test
+	 * @param OutHit Nearest hit with entry point and normal
+	 * @return True if the segment hits a box
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Raycast")
+	static bool RaycastFrameHitboxes(
+		const FFrameHitboxData& FrameData,
+		FVector2D WorldPosition,
+		bool bFlipX,
+		float Scale,
+		FVector2D Start,
+		FVector2D End,
+		EHitboxType Type,
+		FHitboxRaycastResult& OutHit
+	);
+
+	/**
+	 * Slab test a segment against many boxes in one pass
+	 * @param Boxes World-space boxes
+	 * @param Start Segment start
+	 * @param End Segment end
+	 * @param OutTime Fraction along the segment of the nearest entry
+	 * @param OutNormal Normal of the entered face
+	 * @return Index of the nearest box hit, or INDEX_NONE
+	 */
+	static int32 RaycastBoxes(TConstArrayView<FBox2D> Boxes, const FVector2D& Start, const FVector2D& End, float& OutTime, FVector2D& OutNormal);
+
 	// ==========================================
 	// FRAME DATA HELPERS
 	// ==========================================
@@ -192,6 +257,18 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Hitbox|Utilities")
 	static EHitboxType StringToHitboxType(const FString& TypeString);
 
+	/**
+	 * Get the debug color of a hitbox type, the same as in the asset editor (Attack red, Hurtbox green, Collision blue)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Utilities")
+	static FLinearColor GetHitboxTypeColor(EHitboxType Type);
+
+	/**
+	 * Get the debug color of sockets, the same as in the asset editor
+	 */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Utilities")
+	static FLinearColor GetSocketColor() { return FLinearColor::Yellow; }
+
 	/**
 	 * Get the center point of a Box2D
 	 */
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HitboxTypes.h"
+
+class FArchive;
+class AActor;
+class UHitboxDataAsset;
+struct FHitboxParticipant;
+
+/**
+ * Input state of one participant in a capture tick.
+ * Registration fields (owner, asset, team, re-hit interval) are only meaningful when bRegistered is set.
+ */
+struct FHitboxCaptureRecord
+{
+	int32 Id = INDEX_NONE;
+	int32 AnimationIndex = INDEX_NONE;
+	int32 FrameIndex = INDEX_NONE;
+	FVector2f Position = FVector2f::ZeroVector;
+	float Scale = 1.0f;
+	EHitboxProcessingTier Tier = EHitboxProcessingTier::Full;
+	bool bFlipX = false;
+
+	/** Reduced ticks fall where capture tick + TierPhase is a multiple of the reduced interval (first captured tick is 1) */
+	int32 TierPhase = 0;
+
+	/** First record of this participant (or it was registered again with different settings) */
+	bool bRegistered = false;
+
+	/** Index into the capture's owners; participants sharing an owner never hit each other */
+	int32 OwnerIndex = INDEX_NONE;
+
+	/** Index into FHitboxCapture::AssetPaths */
+	int32 AssetIndex = INDEX_NONE;
+
+	int32 Team = 0;
+	float RehitInterval = 0.0f;
+};
+
+/**
+ * Collision inputs of one world tick: participants that went away and participants whose inputs changed
+ */
+struct FHitboxCaptureTick
+{
+	float DeltaTime = 0.0f;
+	TArray<int32> Removed;
+	TArray<FHitboxCaptureRecord> Changed;
+};
+
+/**
+ * Streams world hitbox inputs to a capture file, one block per tick.
+ *
+ * File format: header (magic, version, hit dispatch, attack instance tracking, reduced interval), then blocks:
+ * an asset block (index and path) the first time an asset is referenced, and one tick block per tick
+ * holding only removed participants and participants whose frame, transform, tier or tier phase changed.
+ * Indices are packed ints; positions are stored as floats.
+ */
+class BLUEPRINTHITBOX_API FHitboxCaptureWriter
+{
+public:
+	~FHitboxCaptureWriter();
+
+	/** Create the file and write the header; returns false if the file can't be written */
+	bool Open(const FString& Filename, EHitboxHitDispatch HitDispatch, bool bTrackAttackInstances, int32 ReducedUpdateInterval);
+
+	/** Append one tick with the current state of every participant; TickCounter is the subsystem's, to make tier phases relative */
+	void WriteTick(float DeltaTime, uint32 TickCounter, TConstArrayView<FHitboxParticipant> Participants);
+
+	/** Write the end block and close the file */
+	void Close();
+
+	bool IsOpen() const { return Archive.IsValid(); }
+	const FString& GetFilename() const { return Filename; }
+	int32 GetNumTicks() const { return NumTicks; }
+	int64 GetNumBytes() const;
+
+private:
+	struct FCapturedState
+	{
+		FHitboxCaptureRecord Record;
+		uint32 LastSeenTick;
+	};
+
+	TUniquePtr<FArchive> Archive;
+	FString Filename;
+	int32 NumTicks = 0;
+	int32 ReducedUpdateInterval = 1;
+
+	/** Last written state per participant id */
+	TMap<int32, FCapturedState> Captured;
+
+	TMap<TWeakObjectPtr<AActor>, int32> OwnerIndices;
+	TSet<int32> WrittenAssets;
+
+	// Scratch kept between ticks
+	TArray<int32> Removed;
+	TArray<FHitboxCaptureRecord> Changed;
+};
+
+/**
+ * A capture file read back into memory, for replaying without file access in the timed loop
+ */
+struct BLUEPRINTHITBOX_API FHitboxCapture
+{
+	EHitboxHitDispatch HitDispatch = EHitboxHitDispatch::PerHit;
+	bool bTrackAttackInstances = false;
+	int32 ReducedUpdateInterval = 4;
+
+	/** Asset object paths by capture asset index (empty for indices never written) */
+	TArray<FString> AssetPaths;
+
+	/** Number of distinct owners referenced by OwnerIndex */
+	int32 NumOwners = 0;
+
+	TArray<FHitboxCaptureTick> Ticks;
+
+	/** Read a whole capture file; returns false if it is missing, not a capture or truncated */
+	bool Load(const FString& Filename);
+};
+
+namespace HitboxCapture
+{
+	static constexpr uint32 Magic = 0x43584248; // "HBXC"
+	static constexpr uint32 Version = 2;
+
+	enum class EBlock : uint8
+	{
+		End,
+		Asset,
+		Tick
+	};
+
+	/** Read or write the per-tick part of a record, plus the registration fields when bRegistered is set */
+	BLUEPRINTHITBOX_API void SerializeRecord(FArchive& Ar, FHitboxCaptureRecord& Record);
+}
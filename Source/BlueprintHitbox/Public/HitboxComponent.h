@@ -0,0 +1,240 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HitboxTypes.h"
+#include "HitboxDataAsset.h"
+#include "HitboxWorldCache.h"
+#include "HitboxComponent.generated.h"
+
+class UPaperFlipbookComponent;
+class UHitboxWorldSubsystem;
+class UHitboxComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnHitboxFrameChangedSignature, UHitboxComponent*, Component, int32, AnimationIndex, int32, FrameIndex);
+
+/**
+ * Hitbox placement read from a flipbook component: the resolved animation and frame, and the 2D transform.
+ * Each UHitboxComponent keeps one; the world subsystem keeps those of batched components in one contiguous array.
+ */
+struct BLUEPRINTHITBOX_API FHitboxFlipbookState
+{
+	/** Flipbook AnimationIndex was resolved for */
+	TWeakObjectPtr<UPaperFlipbook> Flipbook;
+
+	/** Index of the animation linked to Flipbook, or -1 */
+	int32 AnimationIndex = INDEX_NONE;
+
+	/** Index of the current frame within the animation, or -1 */
+	int32 FrameIndex = INDEX_NONE;
+
+	/** World position (2D, X/Z) */
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** World Y of the flipbook */
+	double Depth = 0.0;
+
+	float Scale = 1.0f;
+	bool bFlipX = false;
+
+	/** The animation's lookup table matches Flipbook's timing, checked once when the animation is resolved */
+	bool bUseFrameLookup = false;
+
+	/**
+	 * Read playback and transform from a flipbook component; the animation is resolved again only when a different Flipbook plays
+	 * @param FlipbookComponent Flipbook component to read
+	 * @param Data Hitbox data the indices refer to
+	 * @param bAutoFlipX Derive facing from the flipbook transform
+	 * @param bManualFlipX Facing used when bAutoFlipX is off
+	 * @param bOutFrameChanged Set if the animation or frame index changed
+	 * @return True if anything changed
+	 */
+	bool Update(const UPaperFlipbookComponent& FlipbookComponent, const UHitboxDataAsset& Data, bool bAutoFlipX, bool bManualFlipX, bool& bOutFrameChanged);
+};
+
+/**
+ * Tracks a sibling UPaperFlipbookComponent and keeps the matching hitbox frame current.
+ * The playing Flipbook is resolved to an animation through the asset's Flipbook links,
+ * and the current frame is referenced in the asset, never copied.
+ */
+UCLASS(ClassGroup = (Hitbox), meta = (BlueprintSpawnableComponent))
+class BLUEPRINTHITBOX_API UHitboxComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxComponent();
+
+	/** Hitbox data for this actor (animations must have their Flipbook linked) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hitbox")
+	TObjectPtr<UHitboxDataAsset> HitboxData;
+
+	/** Team id, participants on the same non-zero team never hit each other */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hitbox")
+	int32 Team = 0;
+
+	/** Register with the world hitbox subsystem for world processing, queries and push boxes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hitbox")
+	bool bRegisterWithWorld = true;
+
+	/** Seconds before the same attack may hit a defender again in world processing (0 = once per attack) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hitbox")
+	float RehitInterval = 0.0f;
+
+	/** Derive facing from the flipbook (negative X scale or turned to face -X) instead of bFlipX */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox")
+	bool bAutoFlipX = true;
+
+	/** Is the actor facing left (used when bAutoFlipX is off) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox")
+	bool bFlipX = false;
+
+	/**
+	 * Refresh only when the flipbook reaches a different hitbox frame or moves, instead of every tick.
+	 * The tick is scheduled for the next frame change, and at least every EventDrivenFallbackInterval
+	 * so SetFlipbook, Play or SetPlaybackPosition on the flipbook are picked up without calling RefreshFrame.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hitbox")
+	bool bEventDrivenUpdates = false;
+
+	/**
+	 * Longest time between refreshes with bEventDrivenUpdates, also while no frame change is ahead (paused or finished flipbook).
+	 * 0 turns the tick off in that case; RefreshFrame then has to be called after changing the flipbook's playback.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hitbox", meta = (ClampMin = "0", Units = "s", EditCondition = "bEventDrivenUpdates"))
+	float EventDrivenFallbackInterval = 0.25f;
+
+	/**
+	 * Update from the world subsystem's tick in one loop with all other batched components,
+	 * with this component's own tick turned off. Takes precedence over bEventDrivenUpdates.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hitbox")
+	bool bBatchedUpdates = false;
+
+	/** Fired when the animation or frame index changes */
+	UPROPERTY(BlueprintAssignable, Category = "Hitbox|Component")
+	FOnHitboxFrameChangedSignature OnHitboxFrameChanged;
+
+	// ==========================================
+	// BINDING
+	// ==========================================
+
+	/** Track a specific flipbook component (by default the first one on the owner is used) */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Component")
+	void SetFlipbookComponent(UPaperFlipbookComponent* InFlipbookComponent);
+
+	/** Get the tracked flipbook component */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	UPaperFlipbookComponent* GetFlipbookComponent() const { return FlipbookComponent; }
+
+	/** Re-read the flipbook state now instead of waiting for the next tick */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Component")
+	void RefreshFrame();
+
+	// ==========================================
+	// CURRENT STATE
+	// ==========================================
+
+	/** Get current frame data (copies - prefer the collision functions on this component) */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Component")
+	bool GetCurrentFrame(FFrameHitboxData& OutFrame) const;
+
+	/** Direct access to the current frame in the asset, or nullptr */
+	const FFrameHitboxData* GetCurrentFramePtr() const { return CurrentFrame; }
+
+	/** World-space boxes and sockets of the current frame, rebuilt only when frame or transform change */
+	const FHitboxWorldCache& GetWorldBoxes() const { return WorldCache; }
+
+	/** Index of the animation linked to the playing Flipbook, or -1 */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	int32 GetAnimationIndex() const { return FlipbookState.AnimationIndex; }
+
+	/** Index of the current frame within the animation, or -1 */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	int32 GetFrameIndex() const { return FlipbookState.FrameIndex; }
+
+	/** World position (2D, X/Z) the hitboxes are placed at */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	FVector2D GetHitboxPosition() const { return FlipbookState.Position; }
+
+	/** Effective facing used for the hitboxes */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	bool IsFlippedX() const { return FlipbookState.bFlipX; }
+
+	/** Scale used for the hitboxes */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	float GetHitboxScale() const { return FlipbookState.Scale; }
+
+	/** Participant id in the world hitbox subsystem, or -1 if not registered */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	int32 GetParticipantId() const { return ParticipantId; }
+
+	// ==========================================
+	// COLLISION
+	// ==========================================
+
+	/**
+	 * Check this component's attack boxes against another component's hurtboxes
+	 * @param Defender Component to test against
+	 * @param OutResults Array of collision results (one per hit)
+	 * @return True if any collision occurred
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Component")
+	bool CheckCollisionAgainst(const UHitboxComponent* Defender, TArray<FHitboxCollisionResult>& OutResults) const;
+
+	/** Quick check if any of this component's attack boxes overlaps the defender's hurtboxes */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Component")
+	bool QuickHitCheckAgainst(const UHitboxComponent* Defender) const;
+
+	/**
+	 * Get a socket of the current frame in world space
+	 * @param SocketName Socket to find
+	 * @param OutLocation World-space 3D position (Y = owner depth)
+	 * @return True if the current frame has the socket
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Component")
+	bool GetSocketWorldLocation(const FString& SocketName, FVector& OutLocation) const;
+
+	// UActorComponent interface
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	friend class UHitboxWorldSubsystem;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UPaperFlipbookComponent> FlipbookComponent;
+
+	/** Animation, frame and transform last read from the flipbook (written by the subsystem for batched components) */
+	FHitboxFlipbookState FlipbookState;
+
+	const FFrameHitboxData* CurrentFrame = nullptr;
+
+	FHitboxWorldCache WorldCache;
+
+	int32 ParticipantId = INDEX_NONE;
+
+	/** Index in the subsystem's batched components, or -1 */
+	int32 ManagedIndex = INDEX_NONE;
+
+	FDelegateHandle TransformUpdatedHandle;
+
+	UHitboxWorldSubsystem* GetHitboxSubsystem() const;
+
+	/** Read animation, frame and transform from the flipbook; returns true if anything changed */
+	bool UpdateFromFlipbook(bool& bOutFrameChanged);
+
+	/** Take a new flipbook state (from UpdateFromFlipbook or the subsystem's batched update) and rebuild the current frame and world boxes */
+	void ApplyFlipbookState(const FHitboxFlipbookState& NewState);
+
+	/** Seconds until playback reaches a different hitbox frame, 0 to check every tick, or -1 if never */
+	float GetTimeToNextFrameChange() const;
+
+	/** Schedule the tick for the next frame change or turn it off (event-driven updates only) */
+	void ScheduleNextRefresh();
+
+	void OnFlipbookTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+};
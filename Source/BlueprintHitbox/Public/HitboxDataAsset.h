@@ -6,6 +6,60 @@
 #include "PaperFlipbook.h"
 #include "HitboxDataAsset.generated.h"
 
+/**
+ * Memory held by hitbox data, in allocated bytes (FNames live in the shared name table and are not counted)
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxAssetMemory
+{
+	GENERATED_BODY()
+
+	/** Hitbox arrays */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 Boxes = 0;
+
+	/** Socket arrays (names are counted in Names) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 Sockets = 0;
+
+	/** Animation, frame, socket and display name strings, and the import source path */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 Names = 0;
+
+	/** Display frame to hitbox frame tables */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 LookupTables = 0;
+
+	/** Animation and frame arrays */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 Containers = 0;
+
+	/** Asset bundle data (editor builds only) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 EditorData = 0;
+
+	/** The asset object itself */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Memory")
+	int64 Object = 0;
+
+	int64 GetTotal() const
+	{
+		return Boxes + Sockets + Names + LookupTables + Containers + EditorData + Object;
+	}
+
+	FHitboxAssetMemory& operator+=(const FHitboxAssetMemory& Other)
+	{
+		Boxes += Other.Boxes;
+		Sockets += Other.Sockets;
+		Names += Other.Names;
+		LookupTables += Other.LookupTables;
+		Containers += Other.Containers;
+		EditorData += Other.EditorData;
+		Object += Other.Object;
+		return *this;
+	}
+};
+
 /**
  * Animation hitbox data with optional Flipbook reference
  */
@@ -26,6 +80,14 @@ struct BLUEPRINTHITBOX_API FAnimationHitboxData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
 	TArray<FFrameHitboxData> Frames;
 
+	/** Hitbox frame index for each display frame of the linked Flipbook (-1 where no hitbox frame exists) */
+	UPROPERTY(VisibleAnywhere, Category = "Animation", AdvancedDisplay)
+	TArray<int32> DisplayFrameToHitboxFrame;
+
+	/** Frame rate of the linked Flipbook when the lookup table was built */
+	UPROPERTY(VisibleAnywhere, Category = "Animation", AdvancedDisplay)
+	float FlipbookFramesPerSecond = 0.0f;
+
 	/** Get frame data by index */
 	const FFrameHitboxData* GetFrame(int32 Index) const
 	{
@@ -54,6 +116,42 @@ struct BLUEPRINTHITBOX_API FAnimationHitboxData
 	{
 		return Frames.Num();
 	}
+
+	/** Has a display frame lookup table been built for the linked Flipbook */
+	bool HasFrameLookup() const
+	{
+		return DisplayFrameToHitboxFrame.Num() > 0;
+	}
+
+	/** Does the lookup table still match a Flipbook's timing (it may have been retimed after the asset was saved) */
+	bool IsFrameLookupValidFor(const UPaperFlipbook& Flipbook) const
+	{
+		return HasFrameLookup()
+			&& FlipbookFramesPerSecond == Flipbook.GetFramesPerSecond()
+			&& DisplayFrameToHitboxFrame.Num() == Flipbook.GetNumFrames();
+	}
+
+	/** Get hitbox frame index for a Flipbook display frame (e.g. GetPlaybackPositionInFrames), or -1 */
+	int32 GetFrameIndexAtDisplayFrame(int32 DisplayFrame) const
+	{
+		if (DisplayFrameToHitboxFrame.IsValidIndex(DisplayFrame))
+		{
+			return DisplayFrameToHitboxFrame[DisplayFrame];
+		}
+		return INDEX_NONE;
+	}
+
+	/** Get hitbox frame index for a Flipbook playback time in seconds, or -1 */
+	int32 GetFrameIndexAtTime(float PlaybackTime) const
+	{
+		if (!HasFrameLookup()) return INDEX_NONE;
+
+		const int32 DisplayFrame = FMath::TruncToInt32(PlaybackTime * FlipbookFramesPerSecond);
+		return DisplayFrameToHitboxFrame[FMath::Clamp(DisplayFrame, 0, DisplayFrameToHitboxFrame.Num() - 1)];
+	}
+
+	/** Memory allocated by this animation's frames, boxes, sockets, names and lookup table */
+	FHitboxAssetMemory GetMemoryUsage() const;
 };
 
 /**
@@ -119,6 +217,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hitbox Data")
 	bool FindAnimationByFlipbook(UPaperFlipbook* Flipbook, FAnimationHitboxData& OutAnimation) const;
 
+	/** Get frame index for a Flipbook playback time using the precomputed lookup table, or -1 */
+	UFUNCTION(BlueprintPure, Category = "Hitbox Data")
+	int32 GetFrameIndexAtTime(const FString& AnimationName, float PlaybackTime) const;
+
+	/** Get animation index by Flipbook reference, or -1 if no animation links it */
+	UFUNCTION(BlueprintPure, Category = "Hitbox Data")
+	int32 FindAnimationIndexByFlipbook(const UPaperFlipbook* Flipbook) const;
+
+	/** Get animation index by name, or -1 if not found */
+	UFUNCTION(BlueprintPure, Category = "Hitbox Data")
+	int32 FindAnimationIndex(const FString& AnimationName) const;
+
+	/** Direct frame access by animation and frame index (no copy) */
+	const FFrameHitboxData* GetFramePtr(int32 AnimationIndex, int32 FrameIndex) const
+	{
+		if (Animations.IsValidIndex(AnimationIndex))
+		{
+			return Animations[AnimationIndex].GetFrame(FrameIndex);
+		}
+		return nullptr;
+	}
+
 	// ==========================================
 	// DIRECT HITBOX ACCESS
 	// ==========================================
@@ -151,9 +271,27 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Hitbox Data")
 	bool HasAnimation(const FString& AnimationName) const;
 
+	/** Memory used by this asset, by category (same numbers GetResourceSizeEx reports) */
+	UFUNCTION(BlueprintPure, Category = "Hitbox Data")
+	FHitboxAssetMemory GetMemoryUsage() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 	/** Get asset primary ID for async loading */
 	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
 
+#if WITH_EDITOR
+	/**
+	 * Rebuild every animation's display frame -> key frame -> hitbox frame table from its linked Flipbook.
+	 * Called on import, when a Flipbook link changes and before saving, so runtime lookups are a single array index.
+	 * Flipbooks are never loaded here; tables of unloaded Flipbooks are kept and checked again at runtime.
+	 */
+	void RebuildFrameLookupTables();
+
+	virtual void PostEditChangeChainProperty(FPropertyChangedChainEvent& PropertyChangedEvent) override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+#endif
+
 protected:
 	/** Internal lookup - find animation by name */
 	const FAnimationHitboxData* FindAnimation(const FString& AnimationName) const;
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HitboxTypes.h"
+#include "HitboxDataAsset.h"
+#include "HitboxWorldCache.h"
+#include "HitboxParticipant.generated.h"
+
+/**
+ * Defender already hit by a participant's current attack instance
+ */
+struct FHitboxAttackHit
+{
+	int32 DefenderId;
+	double Time;
+};
+
+/**
+ * Recorded hitbox state of a participant at one point in time (lag compensation history)
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxHistoryState
+{
+	GENERATED_BODY()
+
+	/** Subsystem simulation time the state was recorded at */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History")
+	double Time = 0.0;
+
+	/** Index into the asset's animations */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History")
+	int32 AnimationIndex = INDEX_NONE;
+
+	/** Frame within the animation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History")
+	int32 FrameIndex = INDEX_NONE;
+
+	/** World position (2D) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History")
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Scale multiplier */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History")
+	float Scale = 1.0f;
+
+	/** Was the participant facing left */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "History")
+	bool bFlipX = false;
+};
+
+/**
+ * Runtime hitbox state of one entity registered with UHitboxWorldSubsystem.
+ * Frame data is referenced by index into the asset and never copied.
+ */
+USTRUCT()
+struct BLUEPRINTHITBOX_API FHitboxParticipant
+{
+	GENERATED_BODY()
+
+	/** Id handed out at registration */
+	UPROPERTY()
+	int32 Id = INDEX_NONE;
+
+	/** Actor this participant represents */
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Owner;
+
+	/** Hitbox data the animation and frame indices refer to */
+	UPROPERTY()
+	TObjectPtr<UHitboxDataAsset> Asset = nullptr;
+
+	/** Index of Asset in the subsystem's asset table (used by snapshots) */
+	UPROPERTY()
+	int32 AssetIndex = INDEX_NONE;
+
+	/** Index into Asset->Animations, or -1 if no frame is set */
+	UPROPERTY()
+	int32 AnimationIndex = INDEX_NONE;
+
+	/** Index into the animation's Frames */
+	UPROPERTY()
+	int32 FrameIndex = INDEX_NONE;
+
+	/** World position (2D) */
+	UPROPERTY()
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Is the participant facing left */
+	UPROPERTY()
+	bool bFlipX = false;
+
+	/** Scale multiplier */
+	UPROPERTY()
+	float Scale = 1.0f;
+
+	/** Team id, participants on the same non-zero team never hit each other */
+	UPROPERTY()
+	int32 Team = 0;
+
+	/** Current attack instance, a new one starts on the first frame with attack boxes (0 = none yet) */
+	UPROPERTY()
+	int32 AttackId = 0;
+
+	/** Animation the current attack instance started in */
+	UPROPERTY()
+	int32 AttackAnimationIndex = INDEX_NONE;
+
+	/** Did the last processed frame have attack boxes */
+	UPROPERTY()
+	bool bAttackActive = false;
+
+	/** Seconds before the same attack instance can hit a defender again (0 = once per attack) */
+	UPROPERTY()
+	float RehitInterval = 0.0f;
+
+	/** Defenders hit by the current attack instance */
+	TArray<FHitboxAttackHit> HitDefenders;
+
+	/** Processing tier picked by the LOD policy (or forced) */
+	UPROPERTY()
+	EHitboxProcessingTier Tier = EHitboxProcessingTier::Full;
+
+	/** Keep Tier as set instead of evaluating the LOD policy */
+	UPROPERTY()
+	bool bTierForced = false;
+
+	/** Offset of this participant's Reduced ticks, so they are spread over the interval (the id unless set) */
+	UPROPERTY()
+	int32 TierPhase = 0;
+
+	/** Recent states for lag compensation, a ring buffer once full (HistoryHead is the oldest entry) */
+	TArray<FHitboxHistoryState> History;
+	int32 HistoryHead = 0;
+
+	/** World-space boxes and sockets of the current frame, invalidated when frame or transform change */
+	FHitboxWorldCache WorldCache;
+
+	/** Spatial grid items holding this participant's hurtboxes (owned by the subsystem) */
+	TArray<int32, TInlineAllocator<4>> GridItems;
+
+	/** Hurtboxes have to be moved in the grid before its next use */
+	bool bGridDirty = true;
+
+	/** Index of the batched component driving this participant (owned by the subsystem), or -1 */
+	int32 ManagedIndex = INDEX_NONE;
+
+	/** Get the current frame data, or nullptr if none is set */
+	const FFrameHitboxData* GetFrame() const
+	{
+		return Asset ? Asset->GetFramePtr(AnimationIndex, FrameIndex) : nullptr;
+	}
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HitboxTypes.h"
+#include "HitboxReplication.generated.h"
+
+class UPackageMap;
+
+/**
+ * Hitbox state of one entity for replication.
+ * Only indices and a quantized transform go over the wire; clients rebuild the boxes from their own UHitboxDataAsset.
+ *
+ * Wire format: position in 0.1 unit steps (packed ints), facing as 1 bit,
+ * scale as an 8-bit index in 1/16 steps, animation and frame as packed ints.
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxReplicatedState
+{
+	GENERATED_BODY()
+
+	/** World position (2D) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Index into the asset's animations, or -1 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 AnimationIndex = INDEX_NONE;
+
+	/** Frame within the animation, or -1 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 FrameIndex = INDEX_NONE;
+
+	/** Scale multiplier (0 - 15.9375 in 1/16 steps once replicated) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	float Scale = 1.0f;
+
+	/** Is the entity facing left */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	bool bFlipX = false;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FHitboxReplicatedState> : public TStructOpsTypeTraitsBase2<FHitboxReplicatedState>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+/**
+ * A hit for replication: the two actors, the frames and box indices the hit was found with and a 16-bit-per-axis hit offset.
+ * Damage, knockback and the boxes themselves come from the receiver's asset (see UHitboxWorldSubsystem::ResolveReplicatedHit),
+ * looked up in the frames sent, so a receiver whose replicated state is a frame behind or ahead resolves the same boxes.
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxReplicatedHit
+{
+	GENERATED_BODY()
+
+	/** Attacking actor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	TObjectPtr<AActor> Attacker = nullptr;
+
+	/** Actor that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	TObjectPtr<AActor> Defender = nullptr;
+
+	/** Attacker's animation when the hit happened, or -1 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 AttackerAnimationIndex = INDEX_NONE;
+
+	/** Attacker's frame within the animation when the hit happened, or -1 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 AttackerFrameIndex = INDEX_NONE;
+
+	/** Defender's animation when the hit happened, or -1 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 DefenderAnimationIndex = INDEX_NONE;
+
+	/** Defender's frame within the animation when the hit happened, or -1 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 DefenderFrameIndex = INDEX_NONE;
+
+	/** Index of the attack box in the attacker's frame (0 - 255) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 AttackHitboxIndex = 0;
+
+	/** Index of the hurtbox in the defender's frame (0 - 255) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	int32 HurtHitboxIndex = 0;
+
+	/** Hit location relative to the defender's position (whole units, +-32767) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	FVector2D HitOffset = FVector2D::ZeroVector;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FHitboxReplicatedHit> : public TStructOpsTypeTraitsBase2<FHitboxReplicatedHit>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
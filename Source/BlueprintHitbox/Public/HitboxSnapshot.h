@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HitboxTypes.h"
+#include "HitboxParticipant.h"
+#include "HitboxWorldSubsystem.h"
+
+/**
+ * Hitbox state of one participant in a snapshot.
+ * Plain data only (the asset is an index into the subsystem's asset table), so arrays of it copy with memcpy.
+ */
+struct FHitboxParticipantState
+{
+	TWeakObjectPtr<AActor> Owner;
+	int32 Id;
+	int32 AssetIndex;
+	int32 AnimationIndex;
+	int32 FrameIndex;
+	FVector2D Position;
+	float Scale;
+	int32 Team;
+	int32 AttackId;
+	int32 AttackAnimationIndex;
+	float RehitInterval;
+	int32 TierPhase;
+
+	/** Range of this participant's hit registry entries in FHitboxWorldSnapshot::Hits */
+	int32 FirstHit;
+	int32 NumHits;
+
+	EHitboxProcessingTier Tier;
+	bool bFlipX;
+	bool bAttackActive;
+	bool bTierForced;
+};
+
+/**
+ * Rollback snapshot of a UHitboxWorldSubsystem: participants, hit registries and pooled projectiles.
+ * Keep one per rollback frame and reuse it; once its arrays have grown, saving does not allocate.
+ */
+struct BLUEPRINTHITBOX_API FHitboxWorldSnapshot
+{
+	TArray<FHitboxParticipantState> Participants;
+	TArray<FHitboxAttackHit> Hits;
+	TArray<FHitboxProjectile> Projectiles;
+
+	double SimulationTime = 0.0;
+	uint32 TickCounter = 0;
+	int32 NextParticipantId = 1;
+	int32 NextAttackId = 1;
+	int32 NextProjectileId = 1;
+
+	/** Bytes held by the snapshot's arrays */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Participants.GetAllocatedSize() + Hits.GetAllocatedSize() + Projectiles.GetAllocatedSize();
+	}
+};
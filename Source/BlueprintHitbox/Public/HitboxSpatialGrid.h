@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+/**
+ * Uniform hash grid over world-space boxes.
+ * Items can be removed and inserted one at a time, so only boxes that moved are touched;
+ * queries touch only the cells a box covers.
+ */
+class BLUEPRINTHITBOX_API FHitboxSpatialGrid
+{
+public:
+	/** Clear all items and set the cell size used for the next inserts */
+	void Reset(float InCellSize);
+
+	/**
+	 * Add a box to the grid
+	 * @param Box World-space bounds
+	 * @return Item index (indices of removed items are reused first, otherwise items are numbered in insertion order)
+	 */
+	int32 Insert(const FBox2D& Box);
+
+	/** Remove an item from every cell it covers; its index may be handed out again by Insert */
+	void Remove(int32 Item);
+
+	/**
+	 * Find all items whose bounds overlap Box (touching edges count, like FBox2D::Intersect)
+	 * @param Box World-space query bounds
+	 * @param OutItems Receives item indices in ascending order, without duplicates
+	 */
+	void Query(const FBox2D& Box, TArray<int32>& OutItems) const;
+
+	/**
+	 * Find items whose bounds overlap Box, skipping items the filter rejects before their bounds are tested
+	 * @param Box World-space query bounds
+	 * @param OutItems Receives accepted item indices in ascending order, without duplicates
+	 * @param Filter Returns false for items to leave out
+	 */
+	void Query(const FBox2D& Box, TArray<int32>& OutItems, TFunctionRef<bool(int32 Item)> Filter) const;
+
+	/** Get bounds of an item */
+	const FBox2D& GetItemBounds(int32 Item) const { return ItemBounds[Item]; }
+
+	/** Get number of items in the grid */
+	int32 Num() const { return ItemBounds.Num() - FreeItems.Num(); }
+
+	/** Get the cell size */
+	float GetCellSize() const { return CellSize; }
+
+	/** Item bounds tested by queries since the last Reset (for profiling) */
+	int64 GetNumBoundsTests() const { return NumBoundsTests; }
+
+private:
+	/** One item reference in a cell's singly linked list */
+	struct FCellEntry
+	{
+		int32 Item;
+		int32 Next;
+	};
+
+	/** Queries covering more cells than this scan all items instead */
+	static constexpr int32 MaxQueryCells = 1024;
+
+	float CellSize = 256.0f;
+
+	/** Bounds per item index (invalid for removed items) */
+	TArray<FBox2D> ItemBounds;
+	TArray<FCellEntry> CellEntries;
+	TMap<FIntPoint, int32> CellHeads;
+
+	/** Removed item indices, reused by Insert */
+	TArray<int32> FreeItems;
+
+	/** First unused cell entry, linked through Next */
+	int32 FreeEntry = INDEX_NONE;
+
+	/** Per-item stamp used to skip items already reported by another cell */
+	mutable TArray<uint32> QueryStamps;
+	mutable uint32 CurrentStamp = 0;
+
+	mutable int64 NumBoundsTests = 0;
+
+	FIntPoint GetCell(const FVector2D& Point) const;
+
+	template <typename FilterType>
+	void QueryItems(const FBox2D& Box, TArray<int32>& OutItems, const FilterType& Filter) const;
+};
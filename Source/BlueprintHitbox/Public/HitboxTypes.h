@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "HitboxTypes.generated.h"
 
+class AActor;
+
 /**
  * Type of hitbox - matches the editor export format
  */
@@ -14,6 +16,31 @@ enum class EHitboxType : uint8
 	Collision	UMETA(DisplayName = "Collision")
 };
 
+/**
+ * How much world processing a participant gets
+ */
+UENUM(BlueprintType)
+enum class EHitboxProcessingTier : uint8
+{
+	/** Every tick, every box */
+	Full		UMETA(DisplayName = "Full"),
+	/** Attacks checked a fraction of ticks, as one aggregated box */
+	Reduced		UMETA(DisplayName = "Reduced"),
+	/** Attacks never checked, can still be hit */
+	Dormant		UMETA(DisplayName = "Dormant")
+};
+
+/**
+ * How world hit processing delivers hits
+ */
+UENUM(BlueprintType)
+enum class EHitboxHitDispatch : uint8
+{
+	PerHit			UMETA(DisplayName = "Per Hit"),
+	PerTick			UMETA(DisplayName = "Per Tick"),
+	PerDefender		UMETA(DisplayName = "Per Defender")
+};
+
 /**
  * Single hitbox data
  */
@@ -177,3 +204,286 @@ struct BLUEPRINTHITBOX_API FHitboxCollisionResult
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
 	int32 Knockback = 0;
 };
+
+/**
+ * Position correction produced by the push-box solver for one actor
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxPushCorrection
+{
+	GENERATED_BODY()
+
+	/** Actor that should be moved */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
+	TObjectPtr<AActor> Actor = nullptr;
+
+	/** Participant id the correction was computed for */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
+	int32 ParticipantId = INDEX_NONE;
+
+	/** World-space offset to add to the actor's 2D position */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
+	FVector2D Correction = FVector2D::ZeroVector;
+};
+
+/**
+ * Filter for world-space queries against registered hurtboxes
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxQueryFilter
+{
+	GENERATED_BODY()
+
+	/** Team of the querying entity; hurtboxes on the same non-zero team are skipped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	int32 Team = 0;
+
+	/** Actors to skip (e.g. the owner of a projectile) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	TArray<TObjectPtr<AActor>> IgnoredActors;
+
+	/** Report only the first overlapping hurtbox of each actor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	bool bOnePerActor = true;
+};
+
+/**
+ * Hurtbox found by a world-space query
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxOverlapResult
+{
+	GENERATED_BODY()
+
+	/** Actor owning the hurtbox */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	TObjectPtr<AActor> Actor = nullptr;
+
+	/** Participant id of the owner */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	int32 ParticipantId = INDEX_NONE;
+
+	/** The hurtbox that overlaps */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FHitboxData Hurtbox;
+
+	/** World-space bounds of the hurtbox */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FBox2D HurtboxWorld = FBox2D(ForceInit);
+
+	/** World-space center of the overlap */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FVector2D HitLocation = FVector2D::ZeroVector;
+};
+
+/**
+ * Result of a segment cast against hitboxes
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxRaycastResult
+{
+	GENERATED_BODY()
+
+	/** Did the segment hit anything? */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	bool bHit = false;
+
+	/** Actor owning the hit box (world casts only) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	TObjectPtr<AActor> Actor = nullptr;
+
+	/** Participant id of the owner (world casts only) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	int32 ParticipantId = INDEX_NONE;
+
+	/** The box that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	FHitboxData Hitbox;
+
+	/** World-space entry point */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	FVector2D Location = FVector2D::ZeroVector;
+
+	/** Normal of the entered box face (opposes the cast direction if the segment starts inside) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	FVector2D Normal = FVector2D::ZeroVector;
+
+	/** Fraction along the segment from Start (0) to End (1) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	float Time = 1.0f;
+
+	/** Distance from Start to Location */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast")
+	float Distance = 0.0f;
+};
+
+/**
+ * Spawn settings for a pooled projectile
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxProjectileParams
+{
+	GENERATED_BODY()
+
+	/** Velocity in units per second when facing right (X is mirrored when spawned facing left) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	FVector2D Velocity = FVector2D(600.0f, 0.0f);
+
+	/** Half size of the projectile box */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	FVector2D HalfExtents = FVector2D(8.0f, 8.0f);
+
+	/** Seconds before the projectile expires */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	float Lifetime = 2.0f;
+
+	/** Damage dealt on hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	int32 Damage = 0;
+
+	/** Knockback force on hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	int32 Knockback = 0;
+};
+
+/**
+ * A pooled projectile hitting a registered hurtbox
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxProjectileHit
+{
+	GENERATED_BODY()
+
+	/** Id returned when the projectile was spawned */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	int32 ProjectileId = INDEX_NONE;
+
+	/** Actor that spawned the projectile */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	TObjectPtr<AActor> Instigator = nullptr;
+
+	/** Actor that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	TObjectPtr<AActor> Defender = nullptr;
+
+	/** Participant id of the actor that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	int32 DefenderParticipantId = INDEX_NONE;
+
+	/** The hurtbox that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	FHitboxData HurtHitbox;
+
+	/** World-space projectile center at impact */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	FVector2D HitLocation = FVector2D::ZeroVector;
+
+	/** Damage from the projectile */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	int32 Damage = 0;
+
+	/** Knockback from the projectile */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+	int32 Knockback = 0;
+};
+
+/**
+ * One attack box hitting a hurtbox during world hit processing
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxHitEvent
+{
+	GENERATED_BODY()
+
+	/** Attacking actor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	TObjectPtr<AActor> Attacker = nullptr;
+
+	/** Participant id of the attacker */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 AttackerParticipantId = INDEX_NONE;
+
+	/** Actor that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	TObjectPtr<AActor> Defender = nullptr;
+
+	/** Participant id of the actor that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 DefenderParticipantId = INDEX_NONE;
+
+	/** Index of the attack box in the attacker's frame Hitboxes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 AttackHitboxIndex = INDEX_NONE;
+
+	/** Index of the hurtbox in the defender's frame Hitboxes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 HurtHitboxIndex = INDEX_NONE;
+
+	/** Attack box, hurtbox, damage and hit location */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	FHitboxCollisionResult Result;
+};
+
+/**
+ * All hits a defender took in one tick, with damage already summed
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxDefenderHits
+{
+	GENERATED_BODY()
+
+	/** Actor that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	TObjectPtr<AActor> Defender = nullptr;
+
+	/** Participant id of the actor that was hit */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 DefenderParticipantId = INDEX_NONE;
+
+	/** Index of this defender's first hit in the tick's hit array (its hits are contiguous) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 FirstHit = 0;
+
+	/** Number of hits taken this tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 HitCount = 0;
+
+	/** Summed damage, same as GetTotalDamage over this defender's results */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 TotalDamage = 0;
+
+	/** Highest knockback, same as GetMaxKnockback over this defender's results */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hit")
+	int32 MaxKnockback = 0;
+};
+
+/**
+ * Work done and skipped by processing LOD
+ */
+USTRUCT(BlueprintType)
+struct BLUEPRINTHITBOX_API FHitboxLODStats
+{
+	GENERATED_BODY()
+
+	/** Participants per tier */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 NumFull = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 NumReduced = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 NumDormant = 0;
+
+	/** Hurtboxes in the spatial grid at its last rebuild (all tiers) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 HurtboxesIndexed = 0;
+
+	/** Attacker passes run during the last tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 AttackerPassesRun = 0;
+
+	/** Attacker passes skipped during the last tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD")
+	int32 AttackerPassesSkipped = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HitboxTypes.h"
+
+/**
+ * World-space boxes and sockets of one placed frame.
+ * Boxes and Sockets are parallel to the frame's Hitboxes and Sockets arrays,
+ * and are rebuilt only after Invalidate (frame, position, flip or scale changed).
+ */
+struct BLUEPRINTHITBOX_API FHitboxWorldCache
+{
+	/** Frame the cache was built from, or nullptr */
+	const FFrameHitboxData* Frame = nullptr;
+
+	/** World-space box of each of Frame->Hitboxes */
+	TArray<FBox2D> Boxes;
+
+	/** World-space position of each of Frame->Sockets */
+	TArray<FVector2D> Sockets;
+
+	/** Union of all attack boxes (invalid if the frame has none) */
+	FBox2D AttackBounds = FBox2D(ForceInit);
+
+	/** Union of all hurtboxes (invalid if the frame has none) */
+	FBox2D HurtBounds = FBox2D(ForceInit);
+
+	/** Mark the cache stale, the next Update rebuilds it */
+	void Invalidate() { bDirty = true; }
+
+	/** Is the cache stale */
+	bool IsDirty() const { return bDirty; }
+
+	/**
+	 * Rebuild the cache if it was invalidated
+	 * @return True if it was rebuilt
+	 */
+	bool Update(const FFrameHitboxData* InFrame, FVector2D Position, bool bFlipX, float Scale);
+
+	/** Get the world-space position of a socket by name */
+	bool FindSocket(const FString& SocketName, FVector2D& OutPosition) const;
+
+private:
+	bool bDirty = true;
+};
@@ -0,0 +1,629 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitboxTypes.h"
+#include "HitboxParticipant.h"
+#include "HitboxSpatialGrid.h"
+#include "HitboxReplication.h"
+#include "HitboxCapture.h"
+#include "HitboxComponent.h"
+#include "HitboxWorldSubsystem.generated.h"
+
+struct FHitboxWorldSnapshot;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnHitboxHitSignature, AActor*, Attacker, AActor*, Defender, const FHitboxCollisionResult&, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHitboxTickHitsSignature, const TArray<FHitboxHitEvent>&, Hits, const TArray<FHitboxDefenderHits>&, Defenders);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHitboxDefenderHitsSignature, const FHitboxDefenderHits&, DefenderHits);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHitboxProjectileHitSignature, const FHitboxProjectileHit&, Hit);
+
+/**
+ * Pooled projectile simulated by UHitboxWorldSubsystem - a box with no actor or component
+ */
+struct FHitboxProjectile
+{
+	int32 Id;
+	FVector2D Position;
+	FVector2D Velocity;
+	FVector2D HalfExtents;
+	float RemainingLifetime;
+	int32 Damage;
+	int32 Knockback;
+	int32 Team;
+	TWeakObjectPtr<AActor> Instigator;
+};
+
+/**
+ * World-level registry of hitbox participants.
+ * Entities register once and push their frame and transform when they change;
+ * world-wide passes (hit processing, push boxes, queries) then run natively over all of them.
+ */
+UCLASS()
+class BLUEPRINTHITBOX_API UHitboxWorldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Fired for every attack box that hits a hurtbox of another participant during world processing (PerHit dispatch) */
+	UPROPERTY(BlueprintAssignable, Category = "Hitbox|World")
+	FOnHitboxHitSignature OnHitboxHit;
+
+	/** Fired once per tick with all hits sorted by defender and one damage summary per defender (PerTick dispatch) */
+	UPROPERTY(BlueprintAssignable, Category = "Hitbox|World")
+	FOnHitboxTickHitsSignature OnHitboxTickHits;
+
+	/** Fired once per hit defender with its damage summary (PerDefender dispatch, details in GetDefenderTickHits) */
+	UPROPERTY(BlueprintAssignable, Category = "Hitbox|World")
+	FOnHitboxDefenderHitsSignature OnHitboxDefenderHits;
+
+	/** Fired when a pooled projectile hits a hurtbox (the projectile is removed) */
+	UPROPERTY(BlueprintAssignable, Category = "Hitbox|Projectiles")
+	FOnHitboxProjectileHitSignature OnProjectileHit;
+
+	/** Run attack-vs-hurtbox processing between all participants every tick */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|World")
+	bool bEnableHitProcessing = true;
+
+	/**
+	 * Give far-away or unseen participants less work: Reduced participants check their attacks every
+	 * ReducedUpdateInterval ticks as one aggregated box, Dormant ones don't attack at all.
+	 * Only the attacker pass is throttled; every participant's exact hurtboxes stay hittable and queryable
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|LOD")
+	bool bEnableProcessingLOD = false;
+
+	/** Distance from the nearest player view (X/Z plane) beyond which participants are Reduced */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|LOD")
+	float ReducedDistance = 3000.0f;
+
+	/** Distance from the nearest player view (X/Z plane) beyond which participants are Dormant */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|LOD")
+	float DormantDistance = 8000.0f;
+
+	/** Reduced participants are processed once every this many ticks (staggered by id) */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|LOD")
+	int32 ReducedUpdateInterval = 4;
+
+	/** Participants whose owner was not rendered recently are at least Reduced (ignored on dedicated servers) */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|LOD")
+	bool bReduceWhenNotRendered = true;
+
+	/** How hits from world processing are delivered: one event per hit, per tick or per defender */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|World")
+	EHitboxHitDispatch HitDispatch = EHitboxHitDispatch::PerHit;
+
+	/**
+	 * Report each defender once per attack instance (or once per RehitInterval) instead of on every overlapping tick.
+	 * Already-hit defenders are filtered out of the grid query before their hurtboxes are tested.
+	 * Off by default: hit processing reports every overlapping tick unless this is turned on.
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|World")
+	bool bTrackAttackInstances = false;
+
+	// ==========================================
+	// PARTICIPANTS
+	// ==========================================
+
+	/**
+	 * Register an entity for world-level hitbox processing
+	 * @param Owner Actor the participant represents
+	 * @param Asset Hitbox data used by this participant
+	 * @param Team Team id (0 = no team)
+	 * @return Participant id, or -1 if registration failed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	int32 RegisterParticipant(AActor* Owner, UHitboxDataAsset* Asset, int32 Team = 0);
+
+	/** Remove a participant from world-level processing */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	void UnregisterParticipant(int32 ParticipantId);
+
+	/**
+	 * Set the participant's current frame
+	 * @param ParticipantId Id returned by RegisterParticipant
+	 * @param AnimationIndex Index into the asset's animations (see FindAnimationIndex)
+	 * @param FrameIndex Frame within the animation
+	 * @return True if the frame exists
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool SetParticipantFrame(int32 ParticipantId, int32 AnimationIndex, int32 FrameIndex);
+
+	/**
+	 * Set the participant's world transform
+	 * @param ParticipantId Id returned by RegisterParticipant
+	 * @param Position World position (2D)
+	 * @param bFlipX Is the participant facing left
+	 * @param Scale Scale multiplier
+	 * @return True if the participant exists
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool SetParticipantTransform(int32 ParticipantId, FVector2D Position, bool bFlipX, float Scale = 1.0f);
+
+	/**
+	 * Set how often the same attack instance may hit a defender again (multi-hit moves)
+	 * @param ParticipantId Attacking participant
+	 * @param Interval Seconds between hits on the same defender (0 = once per attack)
+	 * @return True if the participant exists
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool SetParticipantRehitInterval(int32 ParticipantId, float Interval);
+
+	/** Start a new attack instance now, so defenders hit by the previous one can be hit again */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool BeginParticipantAttack(int32 ParticipantId);
+
+	/** Get the participant's current attack instance id (0 = none yet, -1 if not registered) */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|World")
+	int32 GetParticipantAttackId(int32 ParticipantId) const;
+
+	/**
+	 * Force a participant's processing tier instead of evaluating the LOD policy (e.g. from a significance manager)
+	 * @param ParticipantId Participant to change
+	 * @param Tier Tier to use
+	 * @param bForce True to keep this tier, false to hand the participant back to the LOD policy
+	 * @return True if the participant exists
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|LOD")
+	bool SetParticipantTier(int32 ParticipantId, EHitboxProcessingTier Tier, bool bForce = true);
+
+	/** Get a participant's current processing tier */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|LOD")
+	EHitboxProcessingTier GetParticipantTier(int32 ParticipantId) const;
+
+	/**
+	 * Pick which ticks a Reduced participant checks its attacks on: those where tick counter + Phase is a multiple
+	 * of ReducedUpdateInterval. Defaults to the participant id, which spreads participants over the interval.
+	 * @return True if the participant exists
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|LOD")
+	bool SetParticipantTierPhase(int32 ParticipantId, int32 Phase);
+
+	/** Get how much work processing LOD skipped */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|LOD")
+	FHitboxLODStats GetLODStats() const { return LODStats; }
+
+	/** Get number of registered participants */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|World")
+	int32 GetParticipantCount() const { return Participants.Num(); }
+
+	/** Find participant state by id */
+	const FHitboxParticipant* FindParticipant(int32 ParticipantId) const;
+
+	/** Get a participant's world-space boxes and sockets, rebuilt first if its frame or transform changed */
+	const FHitboxWorldCache* GetParticipantWorldBoxes(int32 ParticipantId);
+
+	/**
+	 * Check one participant's attack boxes against another's hurtboxes using their cached world boxes
+	 * @param AttackerId Attacking participant
+	 * @param DefenderId Defending participant
+	 * @param OutResults Array of collision results (one per hit)
+	 * @return True if any collision occurred
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool CheckParticipantCollision(int32 AttackerId, int32 DefenderId, TArray<FHitboxCollisionResult>& OutResults);
+
+	// ==========================================
+	// COMPONENTS
+	// ==========================================
+
+	/**
+	 * Update a hitbox component from this subsystem's tick, in one loop with all other batched components,
+	 * instead of from its own tick function (see UHitboxComponent::bBatchedUpdates)
+	 */
+	void AddManagedComponent(UHitboxComponent* Component);
+
+	/** Stop updating a batched hitbox component */
+	void RemoveManagedComponent(UHitboxComponent* Component);
+
+	/** Get number of batched hitbox components */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|World")
+	int32 GetManagedComponentCount() const { return ManagedComponents.Num(); }
+
+	/** Get all hits of the last simulation step (empty if hit processing is off), sorted by defender in PerTick and PerDefender dispatch */
+	TConstArrayView<FHitboxHitEvent> GetTickHits() const { return TickHits; }
+
+	/**
+	 * Get the individual hits behind a defender summary from the last processing pass
+	 * @param DefenderHits Summary received from OnHitboxDefenderHits or OnHitboxTickHits
+	 * @param OutHits The defender's hits, in attacker order
+	 * @return True if the summary refers to the last pass
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool GetDefenderTickHits(const FHitboxDefenderHits& DefenderHits, TArray<FHitboxHitEvent>& OutHits) const;
+
+	// ==========================================
+	// QUERIES
+	// ==========================================
+
+	/**
+	 * Find registered hurtboxes overlapping a world-space box.
+	 * Uses the same spatial grid as world hit processing, so cost scales with the cells covered, not the participant count.
+	 * @param Box World-space query box
+	 * @param Filter Team and actor filtering
+	 * @param OutHits Overlapping hurtboxes, grouped by participant
+	 * @return True if anything overlaps
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool OverlapBox(const FBox2D& Box, const FHitboxQueryFilter& Filter, TArray<FHitboxOverlapResult>& OutHits);
+
+	/**
+	 * Find the first registered hurtbox along a segment (hitscan, lasers).
+	 * Candidates come from the spatial grid, then one batched slab test picks the nearest.
+	 * @param Start Segment start (world space)
+	 * @param End Segment end (world space)
+	 * @param Filter Team and actor filtering (bOnePerActor is ignored)
+	 * @param OutHit Nearest hit with entry point and normal
+	 * @return True if the segment hits a hurtbox
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool RaycastHurtboxes(FVector2D Start, FVector2D End, const FHitboxQueryFilter& Filter, FHitboxRaycastResult& OutHit);
+
+	// ==========================================
+	// PROJECTILES
+	// ==========================================
+
+	/**
+	 * Spawn a pooled projectile
+	 * @param Position World-space spawn position
+	 * @param Params Velocity, size, lifetime and damage
+	 * @param bFlipX Mirror the velocity (spawner facing left)
+	 * @param Team Team id, hurtboxes on the same non-zero team are ignored
+	 * @param Instigator Actor that fired the projectile (never hit by it)
+	 * @return Projectile id, reported again in OnProjectileHit
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Projectiles")
+	int32 SpawnProjectile(FVector2D Position, const FHitboxProjectileParams& Params, bool bFlipX = false, int32 Team = 0, AActor* Instigator = nullptr);
+
+	/**
+	 * Spawn a pooled projectile at a frame socket
+	 * @param Socket Socket to spawn at (e.g. "Muzzle")
+	 * @param WorldPosition Spawner's world position
+	 * @param bFlipX Is the spawner facing left
+	 * @param Scale Spawner's scale
+	 * @param Params Velocity, size, lifetime and damage
+	 * @param Team Team id
+	 * @param Instigator Actor that fired the projectile
+	 * @return Projectile id
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Projectiles")
+	int32 SpawnProjectileFromSocket(const FSocketData& Socket, FVector2D WorldPosition, bool bFlipX, float Scale, const FHitboxProjectileParams& Params, int32 Team = 0, AActor* Instigator = nullptr);
+
+	/**
+	 * Spawn a pooled projectile at a socket of a participant's current frame, using its transform, team and owner
+	 * @param ParticipantId Spawning participant
+	 * @param SocketName Socket on the participant's current frame
+	 * @param Params Velocity, size, lifetime and damage
+	 * @return Projectile id, or -1 if the participant or socket was not found
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Projectiles")
+	int32 SpawnProjectileFromParticipantSocket(int32 ParticipantId, const FString& SocketName, const FHitboxProjectileParams& Params);
+
+	/** Remove all pooled projectiles */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Projectiles")
+	void ClearProjectiles() { Projectiles.Reset(); }
+
+	/** Get number of live pooled projectiles */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Projectiles")
+	int32 GetProjectileCount() const { return Projectiles.Num(); }
+
+	/** Get all live pooled projectiles */
+	TConstArrayView<FHitboxProjectile> GetProjectiles() const { return Projectiles; }
+
+	// ==========================================
+	// PUSH BOXES
+	// ==========================================
+
+	/**
+	 * Separate overlapping Collision boxes of all registered participants.
+	 * Each overlapping pair is pushed apart equally along its axis of least penetration.
+	 * Participant state is not modified - apply the corrections to your actors.
+	 * @param OutCorrections One entry per participant that needs to move
+	 * @param Iterations Number of relaxation passes (more passes settle crowds better)
+	 * @return True if any correction was produced
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|World")
+	bool ResolvePushBoxes(TArray<FHitboxPushCorrection>& OutCorrections, int32 Iterations = 1);
+
+	// ==========================================
+	// LAG COMPENSATION
+	// ==========================================
+
+	/** Record every participant's frame and transform each tick so hits can be checked at past times (server) */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|LagCompensation")
+	bool bRecordHistory = false;
+
+	/** Number of ticks of history kept per participant (can be changed at any time, the oldest records are dropped first) */
+	UPROPERTY(BlueprintReadWrite, Category = "Hitbox|LagCompensation")
+	int32 HistoryLength = 64;
+
+	/**
+	 * Get a participant's recorded state at a past simulation time
+	 * @param ParticipantId Participant to rewind
+	 * @param Timestamp Simulation time (see GetSimulationTime, e.g. a client-reported server time)
+	 * @param bInterpolate Blend position and scale between the surrounding records (frame and facing are not blended)
+	 * @param OutState State at that time
+	 * @return True if the history covers the timestamp
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|LagCompensation")
+	bool GetParticipantStateAtTime(int32 ParticipantId, double Timestamp, bool bInterpolate, FHitboxHistoryState& OutState) const;
+
+	/**
+	 * Check an attacker against a defender as both were at a past time, without moving any actor
+	 * @param AttackerId Attacking participant
+	 * @param DefenderId Defending participant
+	 * @param Timestamp Simulation time to rewind to
+	 * @param bInterpolate Blend positions between records
+	 * @param OutResults Array of collision results (one per hit)
+	 * @return True if any collision occurred at that time
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|LagCompensation")
+	bool CheckRewoundCollision(int32 AttackerId, int32 DefenderId, double Timestamp, bool bInterpolate, TArray<FHitboxCollisionResult>& OutResults) const;
+
+	/**
+	 * Find hurtboxes overlapping a world-space box as they were at a past time
+	 * @param Box World-space query box
+	 * @param Timestamp Simulation time to rewind to
+	 * @param Filter Team and actor filtering
+	 * @param bInterpolate Blend positions between records
+	 * @param OutHits Overlapping hurtboxes at that time, grouped by participant
+	 * @return True if anything overlapped
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|LagCompensation")
+	bool RewoundOverlapBox(const FBox2D& Box, double Timestamp, const FHitboxQueryFilter& Filter, bool bInterpolate, TArray<FHitboxOverlapResult>& OutHits) const;
+
+	// ==========================================
+	// REPLICATION
+	// ==========================================
+
+	/** Get a participant's state in its compact replicated form (server) */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Replication")
+	FHitboxReplicatedState GetParticipantReplicatedState(int32 ParticipantId) const;
+
+	/** Apply a replicated state to a local participant (client); boxes come from the local asset */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Replication")
+	bool ApplyReplicatedState(int32 ParticipantId, const FHitboxReplicatedState& State);
+
+	/** Convert a hit from world processing to its compact replicated form (server); call it in the tick the hit was found */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Replication")
+	FHitboxReplicatedHit MakeReplicatedHit(const FHitboxHitEvent& Hit) const;
+
+	/**
+	 * Rebuild the full collision result of a replicated hit from the local assets, using the frames the hit carries (client)
+	 * @param Hit Hit received from the server
+	 * @param OutResult Attack box, hurtbox, damage, knockback and world hit location
+	 * @return True if both actors are registered locally and the sent frames have the referenced boxes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Replication")
+	bool ResolveReplicatedHit(const FHitboxReplicatedHit& Hit, FHitboxCollisionResult& OutResult) const;
+
+	// ==========================================
+	// ROLLBACK
+	// ==========================================
+
+	/**
+	 * Copy all participant, hit registry and projectile state into a snapshot (reusing its memory).
+	 * Owners and assets are kept by reference, so they must outlive the snapshot.
+	 */
+	void SaveState(FHitboxWorldSnapshot& OutSnapshot) const;
+
+	/**
+	 * Restore the state saved in a snapshot, replacing all participants and projectiles (lag compensation history is cleared).
+	 * Batched components write their flipbook state to their participants again on the next step.
+	 * Participant ids are never handed out twice: components registered after the snapshot still hold their ids,
+	 * so ids keep counting up from the highest one issued instead of the snapshot's.
+	 */
+	void LoadState(const FHitboxWorldSnapshot& Snapshot);
+
+	/**
+	 * Run one step of world processing (batched components, hits, projectiles) without the engine tick.
+	 * Tick calls this; rollback code calls it to resimulate frames after LoadState.
+	 */
+	void AdvanceSimulation(float DeltaTime);
+
+	/** Get the subsystem's simulated time (used for re-hit intervals and history timestamps, saved in snapshots) */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|World")
+	double GetSimulationTime() const { return SimulationTime; }
+
+	// ==========================================
+	// CAPTURE
+	// ==========================================
+
+	/**
+	 * Record the collision inputs of every following tick (frames, transforms, facing, scale, tiers) to a file,
+	 * for replaying offline with the HitboxReplay commandlet. Stops a capture already running.
+	 * @param Filename File to write (usually under Saved/Profiling)
+	 * @return True if the file could be created
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Capture")
+	bool StartCapture(const FString& Filename);
+
+	/** Finish and close the running capture */
+	UFUNCTION(BlueprintCallable, Category = "Hitbox|Capture")
+	void StopCapture();
+
+	/** Is a capture being recorded */
+	UFUNCTION(BlueprintPure, Category = "Hitbox|Capture")
+	bool IsCapturing() const { return Capture.IsValid(); }
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+protected:
+	// UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Hurtbox indexed in the spatial grid; item index in the grid equals index in HurtboxEntries (stale for removed items) */
+	struct FHurtboxEntry
+	{
+		int32 ParticipantIndex;
+		const FHitboxData* Hitbox;
+	};
+
+	/** Batched component state read and compared every tick, parallel to ManagedComponents */
+	struct FManagedState
+	{
+		/** Index in Participants, or -1 if the component has no participant */
+		int32 ParticipantIndex;
+		FHitboxFlipbookState Flipbook;
+
+		/** Write the participant on the next update even if the flipbook didn't change (its state was restored from a snapshot) */
+		bool bForceSync;
+	};
+
+	/** Participant state, packed (unregistered entries are swapped out) */
+	UPROPERTY()
+	TArray<FHitboxParticipant> Participants;
+
+	/** Participant id -> index in Participants, kept in sync on swap removal */
+	TMap<int32, int32> ParticipantIndices;
+
+	int32 NextParticipantId = 1;
+
+	int32 NextAttackId = 1;
+
+	/** Every asset a participant was registered with; snapshots refer to assets by index */
+	UPROPERTY()
+	TArray<TObjectPtr<UHitboxDataAsset>> Assets;
+
+	TMap<TObjectPtr<UHitboxDataAsset>, int32> AssetIndices;
+
+	/** Time advanced by AdvanceSimulation */
+	double SimulationTime = 0.0;
+
+	/** Batched components, packed; each component stores its own index for swap removal */
+	UPROPERTY()
+	TArray<TObjectPtr<UHitboxComponent>> ManagedComponents;
+
+	/** Flipbook state and participant index of each batched component, so the update loop doesn't look participants up by id */
+	TArray<FManagedState> ManagedStates;
+
+	/** Batched components whose frame changed this tick, broadcast after the update loop (scratch) */
+	TArray<TWeakObjectPtr<UHitboxComponent>> FrameChangedComponents;
+
+	/** World-space hurtboxes of all participants */
+	FHitboxSpatialGrid HurtboxGrid;
+	TArray<FHurtboxEntry> HurtboxEntries;
+
+	/** Grid query results, shared by hit processing, queries and projectiles (scratch, never held across a broadcast) */
+	TArray<int32> QueryCandidates;
+
+	/** Defenders the current attacker may not hit again yet, by participant index (hit processing scratch) */
+	TBitArray<> BlockedDefenders;
+
+	/** Hits of the last simulation step, reset every step but reused so it stays pre-sized */
+	UPROPERTY(Transient)
+	TArray<FHitboxHitEvent> TickHits;
+
+	/** Per-defender summaries of TickHits (aggregated dispatch only) */
+	UPROPERTY(Transient)
+	TArray<FHitboxDefenderHits> TickDefenders;
+
+	/** Live pooled projectiles, packed (expired entries are swapped out) */
+	TArray<FHitboxProjectile> Projectiles;
+
+	int32 NextProjectileId = 1;
+
+	/** Ticks since the subsystem started, staggers Reduced participants */
+	uint32 TickCounter = 0;
+
+	FHitboxLODStats LODStats;
+
+	/** Set whenever a participant is marked dirty so the grid is updated before its next use */
+	bool bSpatialIndexDirty = true;
+
+	/** The Hitbox trace channel was on last tick; when it turns on, every asset name is sent again */
+	bool bTraceWasEnabled = false;
+
+	/** Running collision input capture, or null */
+	TUniquePtr<FHitboxCaptureWriter> Capture;
+
+	FHitboxParticipant* FindParticipantMutable(int32 ParticipantId);
+
+	/** Invalidate a participant's world boxes and queue its hurtboxes to be moved in the grid */
+	void MarkParticipantDirty(FHitboxParticipant& Participant);
+
+	/** Find the participant registered for an actor (linear, for infrequent lookups) */
+	const FHitboxParticipant* FindParticipantByOwner(const AActor* Owner) const;
+
+	/** Rebuild stale world box caches and move the grid items of participants marked dirty */
+	void UpdateSpatialIndex();
+
+	/** Take a participant's hurtboxes out of the grid */
+	void RemoveFromSpatialIndex(FHitboxParticipant& Participant);
+
+	/** Empty the grid and mark every participant dirty, so the next update inserts everything again */
+	void ResetSpatialIndex(float CellSize);
+
+	/** Query the hurtbox grid into QueryCandidates, sorted by participant and hurtbox */
+	void QueryHurtboxes(const FBox2D& Box);
+
+	/** Query the hurtbox grid into QueryCandidates, leaving out participants whose bit is set before their boxes are tested */
+	void QueryHurtboxes(const FBox2D& Box, const TBitArray<>& SkipParticipants);
+
+	/** Order QueryCandidates by participant and hurtbox */
+	void SortQueryCandidates();
+
+	/** Append every participant's current state to its history ring */
+	void RecordHistory();
+
+	/** Find a participant's state at a past time in its history ring */
+	bool GetRewoundState(const FHitboxParticipant& Participant, double Timestamp, bool bInterpolate, FHitboxHistoryState& OutState) const;
+
+	/** Pick each participant's processing tier from the distance/visibility policy */
+	void UpdateProcessingTiers();
+
+	/** Should this participant be processed this tick */
+	bool IsTierDue(const FHitboxParticipant& Participant) const;
+
+	/** Read every batched component's flipbook and write changes straight into participant state */
+	void UpdateManagedComponents();
+
+	/** Test every participant's attack boxes against the hurtbox grid and collect TickHits */
+	void ProcessHits();
+
+	/** Deliver TickHits according to HitDispatch */
+	void DispatchHits();
+
+	/** Move all projectiles, sweep them against the hurtbox grid and fire OnProjectileHit */
+	void SimulateProjectiles(float DeltaTime);
+
+	/** Start a new attack instance on the first frame with attack boxes or when the animation changes */
+	void UpdateAttackInstance(FHitboxParticipant& Attacker);
+
+	/**
+	 * Set the BlockedDefenders bit of every defender the attacker's current attack instance hit recently enough to skip
+	 * @return True if any bit was set
+	 */
+	bool MarkBlockedDefenders(const FHitboxParticipant& Attacker, double Now);
+
+	/** Does a query filter accept this participant */
+	bool PassesFilter(const FHitboxQueryFilter& Filter, const FHitboxParticipant& Participant) const;
+
+	/** Can attacker participant hit defender participant (different owner, not on the same team) */
+	bool CanHit(const FHitboxParticipant& Attacker, const FHitboxParticipant& Defender) const;
+
+#if ENABLE_VISUAL_LOG || ENABLE_DRAW_DEBUG
+	/**
+	 * Refresh the world box cache of every participant with a live owner and visit it.
+	 * Visitor is called as (const FHitboxParticipant&, const AActor& Owner, const FHitboxWorldCache&, double Depth),
+	 * Depth being the owner's world Y; the cache has no frame if none is set.
+	 */
+	template <typename VisitorType>
+	void ForEachDebugParticipant(VisitorType&& Visitor);
+#endif
+
+#if ENABLE_VISUAL_LOG
+	/** Record every participant's world boxes and sockets and this tick's hits to the Visual Logger */
+	void LogVisualState();
+#endif
+
+#if ENABLE_DRAW_DEBUG
+	/** Draw every participant's world boxes and sockets (and this tick's hits) with one line batcher call */
+	void DrawDebugState();
+#endif
+};
@@ -12,6 +12,8 @@ public class BlueprintHitboxEditor : ModuleRules
 			"Engine",
 			"UnrealEd",
 			"BlueprintHitbox",
+			"BlueprintHitboxMass",
+			"MassEntity",
 			"Slate",
 			"SlateCore",
 			"EditorStyle",
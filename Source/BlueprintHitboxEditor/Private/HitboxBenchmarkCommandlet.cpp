@@ -0,0 +1,380 @@
+#include "HitboxBenchmarkCommandlet.h"
+#include "HitboxBenchmarkUtils.h"
+#include "HitboxBlueprintLibrary.h"
+#include "HitboxDataAsset.h"
+#include "HitboxWorldCache.h"
+#include "HitboxWorldSubsystem.h"
+#include "HitboxReplication.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+
+namespace HitboxBenchmark
+{
+	/** One timed path of one scenario */
+	struct FResult
+	{
+		FString Scenario;
+		FString Path;
+		int32 Pairs = 0;
+		int32 BoxPairs = 0;
+		int32 Iterations = 0;
+		double Seconds = 0.0;
+		int64 Allocations = 0;
+		int64 Hits = 0;
+
+		/** Replicated bytes per second at 60 ticks per second (world subsystem path only) */
+		bool bMeasuredReplication = false;
+		double StateBytesPerSecond = 0.0;
+		double HitBytesPerSecond = 0.0;
+
+		double NsPerPair() const { return Seconds * 1e9 / FMath::Max<double>(double(Pairs) * Iterations, 1.0); }
+		double NsPerTick() const { return Seconds * 1e9 / FMath::Max(Iterations, 1); }
+		double AllocationsPerTick() const { return double(Allocations) / FMath::Max(Iterations, 1); }
+	};
+
+	/** Ticks the replication bandwidth is measured over, one second at the benchmark's tick rate */
+	static constexpr int32 ReplicationTicks = 60;
+}
+
+bool UHitboxBenchmarkPackageMap::SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID)
+{
+	uint32 Index = Ar.IsSaving() ? ObjectIndices.FindOrAdd(Obj, ObjectIndices.Num()) : 0;
+	Ar.SerializeIntPacked(Index);
+	return true;
+}
+
+UHitboxBenchmarkCommandlet::UHitboxBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UHitboxBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace HitboxBenchmark;
+
+	int32 Iterations = 2000;
+	int32 Seed = 0;
+	float Tolerance = 0.1f;
+	FString OnlyScenario;
+	FString OutputPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("HitboxBenchmark.json"));
+	FString BaselinePath;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+	FParse::Value(*Params, TEXT("Scenario="), OnlyScenario);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+	Iterations = FMath::Max(Iterations, 1);
+
+	TArray<FResult> Results;
+	FHitboxAllocationCounter AllocationCounter;
+
+	for (const FHitboxBenchmarkScenario& Scenario : FHitboxBenchmarkUtils::GetScenarios())
+	{
+		if (!OnlyScenario.IsEmpty() && !OnlyScenario.Equals(Scenario.Name, ESearchCase::IgnoreCase)) continue;
+
+		FRandomStream Random(Seed);
+		UHitboxDataAsset* Asset = FHitboxBenchmarkUtils::MakeScenarioAsset(Scenario, Random);
+		const FAnimationHitboxData& Anim = Asset->Animations[0];
+		const TArray<FHitboxBenchmarkAgent> Agents = FHitboxBenchmarkUtils::MakeScenarioAgents(Scenario, Random);
+
+		// Every cross-team ordered pair
+		TArray<TPair<int32, int32>> Pairs;
+		int32 BoxPairs = 0;
+		for (int32 Attacker = 0; Attacker < Agents.Num(); ++Attacker)
+		{
+			for (int32 Defender = 0; Defender < Agents.Num(); ++Defender)
+			{
+				if (Agents[Attacker].Team == Agents[Defender].Team) continue;
+
+				Pairs.Emplace(Attacker, Defender);
+				const FFrameHitboxData& AttackerFrame = Anim.Frames[Agents[Attacker].FrameIndex];
+				const FFrameHitboxData& DefenderFrame = Anim.Frames[Agents[Defender].FrameIndex];
+				BoxPairs += AttackerFrame.GetHitboxesByType(EHitboxType::Attack).Num() * DefenderFrame.GetHitboxesByType(EHitboxType::Hurtbox).Num();
+			}
+		}
+
+		auto MakeResult = [&](const TCHAR* Path) -> FResult&
+		{
+			FResult& Result = Results.AddDefaulted_GetRef();
+			Result.Scenario = Scenario.Name;
+			Result.Path = Path;
+			Result.Pairs = Pairs.Num();
+			Result.BoxPairs = BoxPairs;
+			Result.Iterations = Iterations;
+			return Result;
+		};
+
+		// Frames advance every tick, like animations would
+		auto FrameAt = [&](const FHitboxBenchmarkAgent& Agent, int32 Iteration) -> const FFrameHitboxData&
+		{
+			return Anim.Frames[FHitboxBenchmarkUtils::GetAgentFrameIndex(Agent, Iteration)];
+		};
+
+		// ------------------------------------------
+		// CheckHitboxCollision
+		// ------------------------------------------
+		{
+			FResult& Result = MakeResult(TEXT("CheckHitboxCollision"));
+			TArray<FHitboxCollisionResult> Hits;
+
+			AllocationCounter.Start();
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (const TPair<int32, int32>& Pair : Pairs)
+				{
+					const FHitboxBenchmarkAgent& A = Agents[Pair.Key];
+					const FHitboxBenchmarkAgent& D = Agents[Pair.Value];
+					UHitboxBlueprintLibrary::CheckHitboxCollision(FrameAt(A, Iteration), A.Position, A.bFlipX, A.Scale, FrameAt(D, Iteration), D.Position, D.bFlipX, D.Scale, Hits);
+					Result.Hits += Hits.Num();
+				}
+			}
+			Result.Seconds = FPlatformTime::Seconds() - Start;
+			Result.Allocations = AllocationCounter.Stop();
+		}
+
+		// ------------------------------------------
+		// QuickHitCheck
+		// ------------------------------------------
+		{
+			FResult& Result = MakeResult(TEXT("QuickHitCheck"));
+
+			AllocationCounter.Start();
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (const TPair<int32, int32>& Pair : Pairs)
+				{
+					const FHitboxBenchmarkAgent& A = Agents[Pair.Key];
+					const FHitboxBenchmarkAgent& D = Agents[Pair.Value];
+					Result.Hits += UHitboxBlueprintLibrary::QuickHitCheck(FrameAt(A, Iteration), A.Position, A.bFlipX, A.Scale, FrameAt(D, Iteration), D.Position, D.bFlipX, D.Scale) ? 1 : 0;
+				}
+			}
+			Result.Seconds = FPlatformTime::Seconds() - Start;
+			Result.Allocations = AllocationCounter.Stop();
+		}
+
+		// ------------------------------------------
+		// CheckCachedCollision (cache rebuilt once per agent per tick, as for a moving component)
+		// ------------------------------------------
+		{
+			FResult& Result = MakeResult(TEXT("CheckCachedCollision"));
+			TArray<FHitboxWorldCache> Caches;
+			Caches.SetNum(Agents.Num());
+			TArray<FHitboxCollisionResult> Hits;
+
+			AllocationCounter.Start();
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				for (int32 Index = 0; Index < Agents.Num(); ++Index)
+				{
+					const FHitboxBenchmarkAgent& Agent = Agents[Index];
+					Caches[Index].Invalidate();
+					Caches[Index].Update(&FrameAt(Agent, Iteration), Agent.Position, Agent.bFlipX, Agent.Scale);
+				}
+				for (const TPair<int32, int32>& Pair : Pairs)
+				{
+					UHitboxBlueprintLibrary::CheckCachedCollision(Caches[Pair.Key], Caches[Pair.Value], Hits);
+					Result.Hits += Hits.Num();
+				}
+			}
+			Result.Seconds = FPlatformTime::Seconds() - Start;
+			Result.Allocations = AllocationCounter.Stop();
+		}
+
+		// ------------------------------------------
+		// World subsystem hit processing
+		// ------------------------------------------
+		{
+			FHitboxBenchmarkWorld BenchmarkWorld;
+			UHitboxWorldSubsystem* Subsystem = BenchmarkWorld.GetSubsystem();
+			if (!Subsystem)
+			{
+				UE_LOG(LogTemp, Error, TEXT("HitboxBenchmark: no hitbox world subsystem in the benchmark world"));
+				return 1;
+			}
+
+			// Attacks register once per attack instance; count every overlap like the other paths
+			Subsystem->bTrackAttackInstances = false;
+
+			TArray<int32> Ids;
+			for (const FHitboxBenchmarkAgent& Agent : Agents)
+			{
+				AActor* Owner = BenchmarkWorld.GetWorld()->SpawnActor<AActor>();
+				const int32 Id = Subsystem->RegisterParticipant(Owner, Asset, Agent.Team);
+				Subsystem->SetParticipantFrame(Id, 0, Agent.FrameIndex);
+				Subsystem->SetParticipantTransform(Id, Agent.Position, Agent.bFlipX, Agent.Scale);
+				Ids.Add(Id);
+			}
+
+			FResult& Result = MakeResult(TEXT("WorldSubsystem"));
+
+			auto Step = [&](int32 Iteration)
+			{
+				for (int32 Index = 0; Index < Agents.Num(); ++Index)
+				{
+					const FHitboxBenchmarkAgent& Agent = Agents[Index];
+					Subsystem->SetParticipantFrame(Ids[Index], 0, FHitboxBenchmarkUtils::GetAgentFrameIndex(Agent, Iteration));
+					Subsystem->SetParticipantTransform(Ids[Index], Agent.Position + FVector2D((Iteration & 1) ? 0.5 : 0.0, 0.0), Agent.bFlipX, Agent.Scale);
+				}
+				Subsystem->AdvanceSimulation(1.0f / 60.0f);
+			};
+
+			// Warm up once so capacity kept between ticks is in place, like in a running game
+			Subsystem->AdvanceSimulation(1.0f / 60.0f);
+
+			AllocationCounter.Start();
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				Step(Iteration);
+				Result.Hits += Subsystem->GetTickHits().Num();
+			}
+			Result.Seconds = FPlatformTime::Seconds() - Start;
+			Result.Allocations = AllocationCounter.Stop();
+
+			// Untimed: every participant's state (all of them change every tick here) and every hit, as the server would send them
+			{
+				UHitboxBenchmarkPackageMap* PackageMap = NewObject<UHitboxBenchmarkPackageMap>();
+				FNetBitWriter Writer(PackageMap, 8 * 1024 * 1024);
+				int64 StateBits = 0;
+				int64 HitBits = 0;
+				bool bSuccess = true;
+
+				for (int32 Tick = 0; Tick < ReplicationTicks; ++Tick)
+				{
+					Step(Iterations + Tick);
+
+					Writer.Reset();
+					for (const int32 Id : Ids)
+					{
+						FHitboxReplicatedState State = Subsystem->GetParticipantReplicatedState(Id);
+						State.NetSerialize(Writer, PackageMap, bSuccess);
+					}
+					StateBits += Writer.GetNumBits();
+
+					Writer.Reset();
+					for (const FHitboxHitEvent& Hit : Subsystem->GetTickHits())
+					{
+						FHitboxReplicatedHit Replicated = Subsystem->MakeReplicatedHit(Hit);
+						Replicated.NetSerialize(Writer, PackageMap, bSuccess);
+					}
+					HitBits += Writer.GetNumBits();
+				}
+
+				const double Seconds = ReplicationTicks / 60.0;
+				Result.bMeasuredReplication = true;
+				Result.StateBytesPerSecond = StateBits / 8.0 / Seconds;
+				Result.HitBytesPerSecond = HitBits / 8.0 / Seconds;
+			}
+
+			for (const int32 Id : Ids)
+			{
+				Subsystem->UnregisterParticipant(Id);
+			}
+		}
+	}
+
+	// ==========================================
+	// REPORT
+	// ==========================================
+
+	TArray<TSharedPtr<FJsonValue>> JsonResults;
+	for (const FResult& Result : Results)
+	{
+		UE_LOG(LogTemp, Display, TEXT("HitboxBenchmark: %-6s %-22s %6d pairs %8.1f ns/pair %10.1f ns/tick %6.2f allocs/tick %lld hits"),
+			*Result.Scenario, *Result.Path, Result.Pairs, Result.NsPerPair(), Result.NsPerTick(), Result.AllocationsPerTick(), Result.Hits);
+
+		TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("scenario"), Result.Scenario);
+		Json->SetStringField(TEXT("path"), Result.Path);
+		Json->SetNumberField(TEXT("pairs"), Result.Pairs);
+		Json->SetNumberField(TEXT("boxPairs"), Result.BoxPairs);
+		Json->SetNumberField(TEXT("iterations"), Result.Iterations);
+		Json->SetNumberField(TEXT("nsPerPair"), Result.NsPerPair());
+		Json->SetNumberField(TEXT("nsPerTick"), Result.NsPerTick());
+		Json->SetNumberField(TEXT("allocationsPerTick"), Result.AllocationsPerTick());
+		Json->SetNumberField(TEXT("hits"), (double)Result.Hits);
+		if (Result.bMeasuredReplication)
+		{
+			UE_LOG(LogTemp, Display, TEXT("HitboxBenchmark: %-6s %-22s %10.0f state bytes/s %10.0f hit bytes/s"),
+				*Result.Scenario, *Result.Path, Result.StateBytesPerSecond, Result.HitBytesPerSecond);
+
+			Json->SetNumberField(TEXT("stateBytesPerSecond"), Result.StateBytesPerSecond);
+			Json->SetNumberField(TEXT("hitBytesPerSecond"), Result.HitBytesPerSecond);
+		}
+		JsonResults.Add(MakeShared<FJsonValueObject>(Json));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Root->SetStringField(TEXT("configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Root->SetNumberField(TEXT("seed"), Seed);
+	Root->SetArrayField(TEXT("results"), JsonResults);
+
+	FString Output;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root, Writer);
+	if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HitboxBenchmark: could not write '%s'"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("HitboxBenchmark: wrote %s"), *OutputPath);
+
+	if (BaselinePath.IsEmpty()) return 0;
+
+	// ==========================================
+	// BASELINE COMPARISON
+	// ==========================================
+
+	FString BaselineText;
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FFileHelper::LoadFileToString(BaselineText, *BaselinePath)
+		|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline)
+		|| !Baseline.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("HitboxBenchmark: could not read baseline '%s'"), *BaselinePath);
+		return 1;
+	}
+
+	bool bRegressed = false;
+	for (const TSharedPtr<FJsonValue>& Value : Baseline->GetArrayField(TEXT("results")))
+	{
+		const TSharedPtr<FJsonObject>& Old = Value->AsObject();
+		const FResult* New = Results.FindByPredicate([&Old](const FResult& Result)
+		{
+			return Result.Scenario == Old->GetStringField(TEXT("scenario")) && Result.Path == Old->GetStringField(TEXT("path"));
+		});
+		if (!New) continue;
+
+		const double OldNs = Old->GetNumberField(TEXT("nsPerPair"));
+		const double OldAllocations = Old->GetNumberField(TEXT("allocationsPerTick"));
+		if (New->NsPerPair() > OldNs * (1.0 + Tolerance))
+		{
+			UE_LOG(LogTemp, Error, TEXT("HitboxBenchmark: %s %s regressed %.1f -> %.1f ns/pair"), *New->Scenario, *New->Path, OldNs, New->NsPerPair());
+			bRegressed = true;
+		}
+		if (New->AllocationsPerTick() > OldAllocations + 0.5)
+		{
+			UE_LOG(LogTemp, Error, TEXT("HitboxBenchmark: %s %s allocations went up %.2f -> %.2f per tick"), *New->Scenario, *New->Path, OldAllocations, New->AllocationsPerTick());
+			bRegressed = true;
+		}
+	}
+	return bRegressed ? 1 : 0;
+}
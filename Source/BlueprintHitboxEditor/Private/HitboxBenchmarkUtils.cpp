@@ -0,0 +1,332 @@
+#include "HitboxBenchmarkUtils.h"
+#include "HitboxCapture.h"
+#include "HitboxDataAsset.h"
+#include "HitboxWorldSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+// ==========================================
+// SYNTHETIC FRAMES
+// ==========================================
+
+FFrameHitboxData FHitboxBenchmarkUtils::MakeFrame(FRandomStream& Random, int32 NumAttack, int32 NumHurt, float Size)
+{
+	FFrameHitboxData Frame;
+	Frame.FrameName = FString::Printf(TEXT("Synthetic_%d_%d"), NumAttack, NumHurt);
+	Frame.Hitboxes.Reserve(NumAttack + NumHurt);
+
+	TArray<EHitboxType> Types;
+	Types.Init(EHitboxType::Hurtbox, NumAttack + NumHurt);
+	for (int32 Index = 0; Index < NumAttack; ++Index)
+	{
+		Types[Index] = EHitboxType::Attack;
+	}
+
+	// Shuffle so no path can rely on boxes being grouped by type
+	for (int32 Index = Types.Num() - 1; Index > 0; --Index)
+	{
+		Types.Swap(Index, Random.RandRange(0, Index));
+	}
+
+	for (const EHitboxType Type : Types)
+	{
+		FHitboxData& Hitbox = Frame.Hitboxes.AddDefaulted_GetRef();
+		Hitbox.Type = Type;
+		if (Type == EHitboxType::Attack)
+		{
+			Hitbox.X = FMath::RoundToInt32(Random.FRandRange(0.0f, 50.0f) * Size);
+			Hitbox.Y = FMath::RoundToInt32(Random.FRandRange(20.0f, 100.0f) * Size);
+			Hitbox.Width = FMath::RoundToInt32(Random.FRandRange(10.0f, 60.0f) * Size);
+			Hitbox.Height = FMath::RoundToInt32(Random.FRandRange(8.0f, 40.0f) * Size);
+			Hitbox.Damage = Random.RandRange(1, 20);
+			Hitbox.Knockback = Random.RandRange(0, 10);
+		}
+		else
+		{
+			Hitbox.X = FMath::RoundToInt32(Random.FRandRange(-30.0f, 10.0f) * Size);
+			Hitbox.Y = FMath::RoundToInt32(Random.FRandRange(0.0f, 100.0f) * Size);
+			Hitbox.Width = FMath::RoundToInt32(Random.FRandRange(10.0f, 40.0f) * Size);
+			Hitbox.Height = FMath::RoundToInt32(Random.FRandRange(10.0f, 40.0f) * Size);
+		}
+	}
+
+	FSocketData& Socket = Frame.Sockets.AddDefaulted_GetRef();
+	Socket.Name = TEXT("Muzzle");
+	Socket.X = FMath::RoundToInt32(40.0f * Size);
+	Socket.Y = FMath::RoundToInt32(60.0f * Size);
+	return Frame;
+}
+
+// ==========================================
+// SCENARIOS
+// ==========================================
+
+static const FHitboxBenchmarkScenario GHitboxBenchmarkScenarios[] = {
+	{ TEXT("1v1"),   1,  3,  4, 1.0f,   1, 3, 4, 1.0f,   80.0f },
+	{ TEXT("4v4"),   4,  3,  4, 1.0f,   4, 3, 4, 1.0f,  400.0f },
+	{ TEXT("Horde"), 1,  3,  4, 1.0f, 300, 1, 2, 1.0f, 4000.0f },
+	{ TEXT("Boss"),  1, 20, 30, 3.0f,   4, 3, 4, 1.0f,  300.0f },
+};
+
+TConstArrayView<FHitboxBenchmarkScenario> FHitboxBenchmarkUtils::GetScenarios()
+{
+	return GHitboxBenchmarkScenarios;
+}
+
+const FHitboxBenchmarkScenario* FHitboxBenchmarkUtils::FindScenario(const FString& Name)
+{
+	for (const FHitboxBenchmarkScenario& Scenario : GHitboxBenchmarkScenarios)
+	{
+		if (Name.Equals(Scenario.Name, ESearchCase::IgnoreCase))
+		{
+			return &Scenario;
+		}
+	}
+	return nullptr;
+}
+
+UHitboxDataAsset* FHitboxBenchmarkUtils::MakeScenarioAsset(const FHitboxBenchmarkScenario& Scenario, FRandomStream& Random)
+{
+	UHitboxDataAsset* Asset = NewObject<UHitboxDataAsset>(GetTransientPackage());
+	FAnimationHitboxData& Anim = Asset->Animations.AddDefaulted_GetRef();
+	Anim.AnimationName = Scenario.Name;
+	for (int32 Frame = 0; Frame < 4; ++Frame)
+	{
+		Anim.Frames.Add(MakeFrame(Random, Scenario.AttackBoxesA, Scenario.HurtBoxesA, Scenario.SizeA));
+	}
+	for (int32 Frame = 0; Frame < 4; ++Frame)
+	{
+		Anim.Frames.Add(MakeFrame(Random, Scenario.AttackBoxesB, Scenario.HurtBoxesB, Scenario.SizeB));
+	}
+	return Asset;
+}
+
+TArray<FHitboxBenchmarkAgent> FHitboxBenchmarkUtils::MakeScenarioAgents(const FHitboxBenchmarkScenario& Scenario, FRandomStream& Random)
+{
+	TArray<FHitboxBenchmarkAgent> Agents;
+	Agents.Reserve(Scenario.NumA + Scenario.NumB);
+	for (int32 Index = 0; Index < Scenario.NumA + Scenario.NumB; ++Index)
+	{
+		const bool bTeamA = Index < Scenario.NumA;
+		FHitboxBenchmarkAgent& Agent = Agents.AddDefaulted_GetRef();
+		Agent.Team = bTeamA ? 1 : 2;
+		Agent.FrameIndex = (bTeamA ? 0 : 4) + Random.RandRange(0, 3);
+		Agent.Position = FVector2D(
+			bTeamA ? Random.FRandRange(-Scenario.Spread * 0.5f, 0.0f) : Random.FRandRange(0.0f, Scenario.Spread * 0.5f),
+			Random.FRandRange(-20.0f, 20.0f));
+		Agent.bFlipX = !bTeamA;
+		Agent.Scale = 1.0f;
+	}
+	return Agents;
+}
+
+// ==========================================
+// ALLOCATION COUNTER
+// ==========================================
+
+FHitboxAllocationCounter::FHitboxAllocationCounter() = default;
+
+FHitboxAllocationCounter::~FHitboxAllocationCounter()
+{
+	if (Inner)
+	{
+		Stop();
+	}
+}
+
+void FHitboxAllocationCounter::Start()
+{
+	check(!Inner);
+	ThreadId = FPlatformTLS::GetCurrentThreadId();
+	NumAllocations = 0;
+	Inner = GMalloc;
+	GMalloc = this;
+}
+
+int64 FHitboxAllocationCounter::Stop()
+{
+	check(Inner && GMalloc == this);
+	GMalloc = Inner;
+	Inner = nullptr;
+	return NumAllocations;
+}
+
+void* FHitboxAllocationCounter::Malloc(SIZE_T Size, uint32 Alignment)
+{
+	Count(Size);
+	return Inner->Malloc(Size, Alignment);
+}
+
+void* FHitboxAllocationCounter::TryMalloc(SIZE_T Size, uint32 Alignment)
+{
+	Count(Size);
+	return Inner->TryMalloc(Size, Alignment);
+}
+
+void* FHitboxAllocationCounter::Realloc(void* Original, SIZE_T Size, uint32 Alignment)
+{
+	Count(Size);
+	return Inner->Realloc(Original, Size, Alignment);
+}
+
+void* FHitboxAllocationCounter::TryRealloc(void* Original, SIZE_T Size, uint32 Alignment)
+{
+	Count(Size);
+	return Inner->TryRealloc(Original, Size, Alignment);
+}
+
+void FHitboxAllocationCounter::Free(void* Original)
+{
+	Inner->Free(Original);
+}
+
+SIZE_T FHitboxAllocationCounter::QuantizeSize(SIZE_T Size, uint32 Alignment)
+{
+	return Inner->QuantizeSize(Size, Alignment);
+}
+
+bool FHitboxAllocationCounter::GetAllocationSize(void* Original, SIZE_T& SizeOut)
+{
+	return Inner->GetAllocationSize(Original, SizeOut);
+}
+
+void FHitboxAllocationCounter::Trim(bool bTrimThreadCaches)
+{
+	Inner->Trim(bTrimThreadCaches);
+}
+
+void FHitboxAllocationCounter::SetupTLSCachesOnCurrentThread()
+{
+	Inner->SetupTLSCachesOnCurrentThread();
+}
+
+void FHitboxAllocationCounter::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	Inner->ClearAndDisableTLSCachesOnCurrentThread();
+}
+
+bool FHitboxAllocationCounter::IsInternallyThreadSafe() const
+{
+	return Inner->IsInternallyThreadSafe();
+}
+
+// ==========================================
+// WORLD
+// ==========================================
+
+FHitboxBenchmarkWorld::FHitboxBenchmarkWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("HitboxBenchmark"));
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+}
+
+FHitboxBenchmarkWorld::~FHitboxBenchmarkWorld()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+UHitboxWorldSubsystem* FHitboxBenchmarkWorld::GetSubsystem() const
+{
+	return World ? World->GetSubsystem<UHitboxWorldSubsystem>() : nullptr;
+}
+
+// ==========================================
+// REPLAY
+// ==========================================
+
+void FHitboxCaptureReplayer::Init(UHitboxWorldSubsystem& InSubsystem, const FHitboxCapture& InCapture, TArray<UHitboxDataAsset*> InAssets, int32 PeakParticipants)
+{
+	Subsystem = &InSubsystem;
+	Capture = &InCapture;
+	Assets = MoveTemp(InAssets);
+
+	Subsystem->HitDispatch = Capture->HitDispatch;
+	Subsystem->bTrackAttackInstances = Capture->bTrackAttackInstances;
+	Subsystem->ReducedUpdateInterval = Capture->ReducedUpdateInterval;
+
+	// Tiers are replayed as recorded instead of being picked again
+	Subsystem->bEnableProcessingLOD = false;
+
+	Owners.Reset();
+	for (int32 Index = 0; Index < Capture->NumOwners; ++Index)
+	{
+		Owners.Add(Subsystem->GetWorld()->SpawnActor<AActor>());
+	}
+
+	Subsystem->SaveState(InitialState);
+
+	// Captured phases count from the first captured tick, replayed ones from the tick counter in the initial state
+	ReducedUpdateInterval = (uint32)FMath::Max(Capture->ReducedUpdateInterval, 1);
+	TierPhaseOffset = ReducedUpdateInterval - InitialState.TickCounter % ReducedUpdateInterval;
+
+	CaptureToReplay.Reset();
+	ReplayToCapture.Reset();
+	CaptureToReplay.Reserve(PeakParticipants);
+	ReplayToCapture.Reserve(PeakParticipants);
+}
+
+void FHitboxCaptureReplayer::Rewind()
+{
+	// Restores the tick counter and every participant, but not the next id, so ids go through CaptureToReplay
+	Subsystem->LoadState(InitialState);
+	CaptureToReplay.Reset();
+	ReplayToCapture.Reset();
+}
+
+void FHitboxCaptureReplayer::Replay(int64& OutHits, uint64& OutChecksum)
+{
+	for (const FHitboxCaptureTick& Tick : Capture->Ticks)
+	{
+		for (const int32 Id : Tick.Removed)
+		{
+			int32 ReplayId = INDEX_NONE;
+			if (CaptureToReplay.RemoveAndCopyValue(Id, ReplayId))
+			{
+				Subsystem->UnregisterParticipant(ReplayId);
+				ReplayToCapture.Remove(ReplayId);
+			}
+		}
+
+		for (const FHitboxCaptureRecord& Record : Tick.Changed)
+		{
+			int32& ReplayId = CaptureToReplay.FindOrAdd(Record.Id, INDEX_NONE);
+			if (Record.bRegistered)
+			{
+				if (ReplayId != INDEX_NONE)
+				{
+					Subsystem->UnregisterParticipant(ReplayId);
+					ReplayToCapture.Remove(ReplayId);
+				}
+				ReplayId = Subsystem->RegisterParticipant(Owners[Record.OwnerIndex], Assets[Record.AssetIndex], Record.Team);
+				Subsystem->SetParticipantRehitInterval(ReplayId, Record.RehitInterval);
+				ReplayToCapture.Add(ReplayId, Record.Id);
+			}
+
+			Subsystem->SetParticipantFrame(ReplayId, Record.AnimationIndex, Record.FrameIndex);
+			Subsystem->SetParticipantTransform(ReplayId, FVector2D(Record.Position), Record.bFlipX, Record.Scale);
+			Subsystem->SetParticipantTier(ReplayId, Record.Tier, true);
+			Subsystem->SetParticipantTierPhase(ReplayId, (int32)(((uint32)Record.TierPhase + TierPhaseOffset) % ReducedUpdateInterval));
+		}
+
+		Subsystem->AdvanceSimulation(Tick.DeltaTime);
+
+		for (const FHitboxHitEvent& Hit : Subsystem->GetTickHits())
+		{
+			OutChecksum += HashHit(Hit, ReplayToCapture.FindRef(Hit.AttackerParticipantId), ReplayToCapture.FindRef(Hit.DefenderParticipantId));
+		}
+		OutHits += Subsystem->GetTickHits().Num();
+	}
+}
+
+uint32 FHitboxCaptureReplayer::HashHit(const FHitboxHitEvent& Hit, int32 AttackerCaptureId, int32 DefenderCaptureId)
+{
+	uint32 Hash = HashCombineFast(GetTypeHash(AttackerCaptureId), GetTypeHash(DefenderCaptureId));
+	Hash = HashCombineFast(Hash, GetTypeHash(Hit.AttackHitboxIndex));
+	return HashCombineFast(Hash, GetTypeHash(Hit.HurtHitboxIndex));
+}
@@ -1,5 +1,6 @@
 #include "HitboxDataAssetEditor.h"
 #include "HitboxJsonImporter.h"
+#include "HitboxBlueprintLibrary.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SSplitter.h"
 #include "Widgets/Layout/SBox.h"
@@ -161,7 +162,7 @@ int32 SHitboxPreviewWidget::OnPaint(const FPaintArgs& Args, const FGeometry& All
 			AllottedGeometry.ToPaintGeometry(),
 			HLine,
 			ESlateDrawEffect::None,
-			FLinearColor::Yellow,
+			UHitboxBlueprintLibrary::GetSocketColor(),
 			true,
 			2.0f
 		);
@@ -171,7 +172,7 @@ int32 SHitboxPreviewWidget::OnPaint(const FPaintArgs& Args, const FGeometry& All
 			AllottedGeometry.ToPaintGeometry(),
 			VLine,
 			ESlateDrawEffect::None,
-			FLinearColor::Yellow,
+			UHitboxBlueprintLibrary::GetSocketColor(),
 			true,
 			2.0f
 		);
@@ -182,13 +183,8 @@ int32 SHitboxPreviewWidget::OnPaint(const FPaintArgs& Args, const FGeometry& All
 
 FLinearColor SHitboxPreviewWidget::GetHitboxColor(EHitboxType Type) const
 {
-	switch (Type)
-	{
-		case EHitboxType::Attack: return FLinearColor::Red;
-		case EHitboxType::Hurtbox: return FLinearColor::Green;
-		case EHitboxType::Collision: return FLinearColor::Blue;
-		default: return FLinearColor::White;
-	}
+	// Shared with runtime debug drawing and the Visual Logger
+	return UHitboxBlueprintLibrary::GetHitboxTypeColor(Type);
 }
 
 const FFrameHitboxData* SHitboxPreviewWidget::GetCurrentFrame() const
@@ -146,6 +146,7 @@ UHitboxDataAsset* FHitboxJsonImporter::ImportFromFile(
 	NewAsset->Animations = Animations;
 	NewAsset->SourceFilePath = JsonFilePath;
 	NewAsset->LastImportTime = FDateTime::Now();
+	NewAsset->RebuildFrameLookupTables();
 
 	// Mark dirty and save
 	NewAsset->MarkPackageDirty();
@@ -217,6 +218,7 @@ bool FHitboxJsonImporter::ReimportAsset(UHitboxDataAsset* Asset, FString& OutErr
 			Anim.Flipbook = *Flipbook;
 		}
 	}
+	Asset->RebuildFrameLookupTables();
 
 	Asset->MarkPackageDirty();
 
@@ -0,0 +1,461 @@
+#include "HitboxOracleCommandlet.h"
+#include "HitboxBenchmarkUtils.h"
+#include "HitboxBlueprintLibrary.h"
+#include "HitboxDataAsset.h"
+#include "HitboxSpatialGrid.h"
+#include "HitboxWorldCache.h"
+#include "HitboxWorldSubsystem.h"
+#include "HitboxMassFragments.h"
+#include "HitboxMassProcessors.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassExecutor.h"
+#include "MassProcessingTypes.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+
+namespace HitboxOracle
+{
+	struct FAgent
+	{
+		FFrameHitboxData Frame;
+		FVector2D Position;
+		bool bFlipX;
+		float Scale;
+	};
+
+	// ==========================================
+	// REFERENCE
+	// ==========================================
+
+	/** Frozen copy of HitboxToWorldSpace as the reference was written */
+	static FBox2D ReferenceToWorld(const FHitboxData& Hitbox, FVector2D WorldPosition, bool bFlipX, float Scale)
+	{
+		float X = Hitbox.X * Scale;
+		float Y = Hitbox.Y * Scale;
+		float W = Hitbox.Width * Scale;
+		float H = Hitbox.Height * Scale;
+
+		if (bFlipX)
+		{
+			X = -(X + W);
+		}
+
+		return FBox2D(
+			FVector2D(WorldPosition.X + X, WorldPosition.Y + Y),
+			FVector2D(WorldPosition.X + X + W, WorldPosition.Y + Y + H)
+		);
+	}
+
+	/** Frozen copy of the brute-force CheckHitboxCollision */
+	static void ReferenceCheck(const FAgent& Attacker, const FAgent& Defender, TArray<FHitboxCollisionResult>& OutResults)
+	{
+		OutResults.Reset();
+
+		const TArray<FHitboxData> AttackBoxes = Attacker.Frame.GetHitboxesByType(EHitboxType::Attack);
+		const TArray<FHitboxData> HurtBoxes = Defender.Frame.GetHitboxesByType(EHitboxType::Hurtbox);
+
+		for (const FHitboxData& Attack : AttackBoxes)
+		{
+			const FBox2D AttackWorld = ReferenceToWorld(Attack, Attacker.Position, Attacker.bFlipX, Attacker.Scale);
+			for (const FHitboxData& Hurt : HurtBoxes)
+			{
+				const FBox2D HurtWorld = ReferenceToWorld(Hurt, Defender.Position, Defender.bFlipX, Defender.Scale);
+
+				// FBox2D::Intersect is inclusive: boxes sharing only an edge or corner collide
+				if (AttackWorld.Min.X > HurtWorld.Max.X || HurtWorld.Min.X > AttackWorld.Max.X) continue;
+				if (AttackWorld.Min.Y > HurtWorld.Max.Y || HurtWorld.Min.Y > AttackWorld.Max.Y) continue;
+
+				FHitboxCollisionResult& Result = OutResults.AddDefaulted_GetRef();
+				Result.bHit = true;
+				Result.AttackHitbox = Attack;
+				Result.HurtHitbox = Hurt;
+				Result.Damage = Attack.Damage;
+				Result.Knockback = Attack.Knockback;
+				Result.HitLocation = FBox2D(
+					FVector2D(FMath::Max(AttackWorld.Min.X, HurtWorld.Min.X), FMath::Max(AttackWorld.Min.Y, HurtWorld.Min.Y)),
+					FVector2D(FMath::Min(AttackWorld.Max.X, HurtWorld.Max.X), FMath::Min(AttackWorld.Max.Y, HurtWorld.Max.Y))
+				).GetCenter();
+			}
+		}
+	}
+
+	// ==========================================
+	// GENERATION
+	// ==========================================
+
+	/** Small integer coordinates so edges and corners coincide often */
+	static FFrameHitboxData MakeEdgeFrame(FRandomStream& Random)
+	{
+		FFrameHitboxData Frame;
+		const int32 NumBoxes = Random.RandRange(0, 10);
+		for (int32 Index = 0; Index < NumBoxes; ++Index)
+		{
+			FHitboxData& Hitbox = Frame.Hitboxes.AddDefaulted_GetRef();
+			Hitbox.Type = (EHitboxType)Random.RandRange(0, 2);
+			Hitbox.X = Random.RandRange(-20, 20);
+			Hitbox.Y = Random.RandRange(-20, 20);
+			Hitbox.Width = Random.RandRange(0, 3) == 0 ? 0 : Random.RandRange(1, 20);
+			Hitbox.Height = Random.RandRange(0, 3) == 0 ? 0 : Random.RandRange(1, 20);
+			Hitbox.Damage = Random.RandRange(0, 99);
+			Hitbox.Knockback = Random.RandRange(0, 99);
+		}
+		return Frame;
+	}
+
+	static FAgent MakeAgent(FRandomStream& Random)
+	{
+		static const float Scales[] = { 1.0f, 1.0f, 1.0f, 0.5f, 2.0f, 0.25f };
+
+		FAgent Agent;
+		Agent.Frame = Random.RandRange(0, 3) == 0
+			? FHitboxBenchmarkUtils::MakeFrame(Random, Random.RandRange(0, 6), Random.RandRange(0, 6), Random.FRandRange(0.5f, 2.0f))
+			: MakeEdgeFrame(Random);
+		Agent.Position = Random.RandRange(0, 3) == 0
+			? FVector2D(Random.FRandRange(-40.0f, 40.0f), Random.FRandRange(-40.0f, 40.0f))
+			: FVector2D(Random.RandRange(-30, 30), Random.RandRange(-30, 30));
+		Agent.bFlipX = Random.RandRange(0, 1) == 1;
+		Agent.Scale = Random.RandRange(0, 4) == 0 ? Random.FRandRange(0.1f, 3.0f) : Scales[Random.RandRange(0, UE_ARRAY_COUNT(Scales) - 1)];
+		return Agent;
+	}
+
+	// ==========================================
+	// COMPARISON
+	// ==========================================
+
+	static bool SameHitbox(const FHitboxData& A, const FHitboxData& B)
+	{
+		return A.Type == B.Type && A.X == B.X && A.Y == B.Y && A.Width == B.Width && A.Height == B.Height
+			&& A.Damage == B.Damage && A.Knockback == B.Knockback;
+	}
+
+	/** Empty if equal, otherwise a description of the first difference */
+	static FString Compare(const TArray<FHitboxCollisionResult>& Expected, TConstArrayView<FHitboxCollisionResult> Actual, double Epsilon)
+	{
+		if (Expected.Num() != Actual.Num())
+		{
+			return FString::Printf(TEXT("%d results, expected %d"), Actual.Num(), Expected.Num());
+		}
+
+		for (int32 Index = 0; Index < Expected.Num(); ++Index)
+		{
+			const FHitboxCollisionResult& E = Expected[Index];
+			const FHitboxCollisionResult& A = Actual[Index];
+			if (!SameHitbox(E.AttackHitbox, A.AttackHitbox) || !SameHitbox(E.HurtHitbox, A.HurtHitbox))
+			{
+				return FString::Printf(TEXT("result %d pairs different boxes (order or selection)"), Index);
+			}
+			if (!A.bHit || A.Damage != E.Damage || A.Knockback != E.Knockback)
+			{
+				return FString::Printf(TEXT("result %d: bHit %d damage %d knockback %d, expected 1 %d %d"), Index, A.bHit, A.Damage, A.Knockback, E.Damage, E.Knockback);
+			}
+			if (!A.HitLocation.Equals(E.HitLocation, Epsilon))
+			{
+				return FString::Printf(TEXT("result %d: location %s, expected %s"), Index, *A.HitLocation.ToString(), *E.HitLocation.ToString());
+			}
+		}
+		return FString();
+	}
+
+	static FString Describe(const FAgent& Agent)
+	{
+		FString Text = FString::Printf(TEXT("pos %s flip %d scale %.9g boxes"), *Agent.Position.ToString(), Agent.bFlipX, Agent.Scale);
+		for (const FHitboxData& Hitbox : Agent.Frame.Hitboxes)
+		{
+			Text += FString::Printf(TEXT(" [%s %d,%d %dx%d]"), *UHitboxBlueprintLibrary::HitboxTypeToString(Hitbox.Type), Hitbox.X, Hitbox.Y, Hitbox.Width, Hitbox.Height);
+		}
+		return Text;
+	}
+}
+
+UHitboxOracleCommandlet::UHitboxOracleCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UHitboxOracleCommandlet::Main(const FString& Params)
+{
+	using namespace HitboxOracle;
+
+	int32 Cases = 100000;
+	int32 Seed = 0;
+	int32 WorldEvery = 16;
+	double Epsilon = 0.0;
+	FParse::Value(*Params, TEXT("Cases="), Cases);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("WorldEvery="), WorldEvery);
+	FParse::Value(*Params, TEXT("Epsilon="), Epsilon);
+
+	FHitboxBenchmarkWorld OracleWorld;
+	UHitboxWorldSubsystem* Subsystem = OracleWorld.GetSubsystem();
+	if (!Subsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HitboxOracle: no hitbox world subsystem in the oracle world"));
+		return 1;
+	}
+	Subsystem->bTrackAttackInstances = false;
+
+	// Participants read frames from an asset; its frames are replaced for every world case
+	UHitboxDataAsset* Asset = NewObject<UHitboxDataAsset>(GetTransientPackage());
+	Asset->Animations.AddDefaulted();
+
+	// Mass agents read the same asset; no team fragment, so like the participants every agent can hit every other
+	UMassEntitySubsystem* EntitySubsystem = OracleWorld.GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+	if (!EntitySubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HitboxOracle: no Mass entity subsystem in the oracle world"));
+		return 1;
+	}
+	FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+	const FMassArchetypeHandle MassArchetype = EntityManager.CreateArchetype({
+		FHitboxAnimationFragment::StaticStruct(),
+		FHitboxTransformFragment::StaticStruct(),
+		FHitboxBoundsFragment::StaticStruct(),
+		FHitboxDamageFragment::StaticStruct()
+	});
+
+	FHitboxAssetFragment AssetFragment;
+	AssetFragment.Asset = Asset;
+	FMassArchetypeSharedFragmentValues MassSharedValues;
+	MassSharedValues.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(AssetFragment));
+	MassSharedValues.Sort();
+
+	UHitboxWorldTransformProcessor* MassTransformProcessor = NewObject<UHitboxWorldTransformProcessor>(GetTransientPackage());
+	UHitboxCollisionProcessor* MassCollisionProcessor = NewObject<UHitboxCollisionProcessor>(GetTransientPackage());
+	MassTransformProcessor->CallInitialize(OracleWorld.GetWorld());
+	MassCollisionProcessor->CallInitialize(OracleWorld.GetWorld());
+	TArray<FMassEntityHandle> MassEntities;
+
+	TArray<AActor*> Owners;
+	TArray<FHitboxCollisionResult> Expected;
+	TArray<FHitboxCollisionResult> Actual;
+	TArray<FHitboxWorldCache> Caches;
+	TArray<int32> GridItems;
+	FHitboxSpatialGrid Grid;
+
+	int64 PairsChecked = 0;
+	int64 ExpectedHits = 0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Case = 0; Case < Cases; ++Case)
+	{
+		const int32 CaseSeed = Seed + Case;
+		FRandomStream Random(CaseSeed);
+
+		TArray<FAgent> Agents;
+		const int32 NumAgents = Random.RandRange(2, 6);
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			Agents.Add(MakeAgent(Random));
+		}
+
+		auto Fail = [&](const TCHAR* Path, int32 AttackerIndex, int32 DefenderIndex, const FString& Difference)
+		{
+			UE_LOG(LogTemp, Error, TEXT("HitboxOracle: %s diverges from the reference in case seed %d (attacker %d, defender %d): %s"),
+				Path, CaseSeed, AttackerIndex, DefenderIndex, *Difference);
+			UE_LOG(LogTemp, Error, TEXT("HitboxOracle:   attacker %s"), *Describe(Agents[AttackerIndex]));
+			UE_LOG(LogTemp, Error, TEXT("HitboxOracle:   defender %s"), *Describe(Agents[DefenderIndex]));
+			UE_LOG(LogTemp, Error, TEXT("HitboxOracle: reproduce with -run=HitboxOracle -Seed=%d -Cases=1 -WorldEvery=1"), CaseSeed);
+			return 1;
+		};
+
+		Caches.SetNum(NumAgents);
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			Caches[Index].Invalidate();
+			Caches[Index].Update(&Agents[Index].Frame, Agents[Index].Position, Agents[Index].bFlipX, Agents[Index].Scale);
+		}
+
+		// ------------------------------------------
+		// Pair paths
+		// ------------------------------------------
+		for (int32 AttackerIndex = 0; AttackerIndex < NumAgents; ++AttackerIndex)
+		{
+			for (int32 DefenderIndex = 0; DefenderIndex < NumAgents; ++DefenderIndex)
+			{
+				if (AttackerIndex == DefenderIndex) continue;
+
+				const FAgent& A = Agents[AttackerIndex];
+				const FAgent& D = Agents[DefenderIndex];
+				ReferenceCheck(A, D, Expected);
+				++PairsChecked;
+				ExpectedHits += Expected.Num();
+
+				UHitboxBlueprintLibrary::CheckHitboxCollision(A.Frame, A.Position, A.bFlipX, A.Scale, D.Frame, D.Position, D.bFlipX, D.Scale, Actual);
+				FString Difference = Compare(Expected, Actual, Epsilon);
+				if (!Difference.IsEmpty()) return Fail(TEXT("CheckHitboxCollision"), AttackerIndex, DefenderIndex, Difference);
+
+				if (UHitboxBlueprintLibrary::QuickHitCheck(A.Frame, A.Position, A.bFlipX, A.Scale, D.Frame, D.Position, D.bFlipX, D.Scale) != (Expected.Num() > 0))
+				{
+					return Fail(TEXT("QuickHitCheck"), AttackerIndex, DefenderIndex, FString::Printf(TEXT("returned %d"), Expected.Num() == 0));
+				}
+
+				UHitboxBlueprintLibrary::CheckCachedCollision(Caches[AttackerIndex], Caches[DefenderIndex], Actual);
+				Difference = Compare(Expected, Actual, Epsilon);
+				if (!Difference.IsEmpty()) return Fail(TEXT("CheckCachedCollision"), AttackerIndex, DefenderIndex, Difference);
+
+				if (UHitboxBlueprintLibrary::QuickCachedHitCheck(Caches[AttackerIndex], Caches[DefenderIndex]) != (Expected.Num() > 0))
+				{
+					return Fail(TEXT("QuickCachedHitCheck"), AttackerIndex, DefenderIndex, FString::Printf(TEXT("returned %d"), Expected.Num() == 0));
+				}
+			}
+		}
+
+		// ------------------------------------------
+		// Spatial grid against a linear scan
+		// ------------------------------------------
+		Grid.Reset(Random.FRandRange(4.0f, 64.0f));
+		TArray<FBox2D> Hurtboxes;
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			const TArray<FHitboxData>& Hitboxes = Agents[Index].Frame.Hitboxes;
+			for (int32 HitboxIndex = 0; HitboxIndex < Hitboxes.Num(); ++HitboxIndex)
+			{
+				if (Hitboxes[HitboxIndex].Type != EHitboxType::Hurtbox) continue;
+
+				Grid.Insert(Caches[Index].Boxes[HitboxIndex]);
+				Hurtboxes.Add(Caches[Index].Boxes[HitboxIndex]);
+			}
+		}
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			for (const FBox2D& AttackWorld : Caches[Index].Boxes)
+			{
+				GridItems.Reset();
+				Grid.Query(AttackWorld, GridItems);
+
+				int32 Found = 0;
+				for (int32 Item = 0; Item < Hurtboxes.Num(); ++Item)
+				{
+					if (!AttackWorld.Intersect(Hurtboxes[Item])) continue;
+
+					if (!GridItems.IsValidIndex(Found) || GridItems[Found] != Item)
+					{
+						return Fail(TEXT("FHitboxSpatialGrid::Query"), Index, Index, FString::Printf(TEXT("missing or out-of-order item %d"), Item));
+					}
+					++Found;
+				}
+				if (Found != GridItems.Num())
+				{
+					return Fail(TEXT("FHitboxSpatialGrid::Query"), Index, Index, FString::Printf(TEXT("%d items, expected %d"), GridItems.Num(), Found));
+				}
+			}
+		}
+
+		// ------------------------------------------
+		// World subsystem hit processing
+		// ------------------------------------------
+		if (WorldEvery <= 0 || Case % WorldEvery != 0) continue;
+
+		TArray<FFrameHitboxData>& Frames = Asset->Animations[0].Frames;
+		Frames.Reset();
+		TArray<int32> Ids;
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			if (!Owners.IsValidIndex(Index))
+			{
+				Owners.Add(OracleWorld.GetWorld()->SpawnActor<AActor>());
+			}
+			Frames.Add(Agents[Index].Frame);
+		}
+		for (int32 Index = 0; Index < NumAgents; ++Index)
+		{
+			const int32 Id = Subsystem->RegisterParticipant(Owners[Index], Asset, 0);
+			Subsystem->SetParticipantFrame(Id, 0, Index);
+			Subsystem->SetParticipantTransform(Id, Agents[Index].Position, Agents[Index].bFlipX, Agents[Index].Scale);
+			Ids.Add(Id);
+		}
+
+		Subsystem->AdvanceSimulation(1.0f / 60.0f);
+		const TConstArrayView<FHitboxHitEvent> TickHits = Subsystem->GetTickHits();
+
+		for (int32 AttackerIndex = 0; AttackerIndex < NumAgents; ++AttackerIndex)
+		{
+			for (int32 DefenderIndex = 0; DefenderIndex < NumAgents; ++DefenderIndex)
+			{
+				if (AttackerIndex == DefenderIndex) continue;
+
+				ReferenceCheck(Agents[AttackerIndex], Agents[DefenderIndex], Expected);
+
+				Actual.Reset();
+				for (const FHitboxHitEvent& Hit : TickHits)
+				{
+					if (Hit.AttackerParticipantId == Ids[AttackerIndex] && Hit.DefenderParticipantId == Ids[DefenderIndex])
+					{
+						Actual.Add(Hit.Result);
+					}
+				}
+
+				const FString Difference = Compare(Expected, Actual, Epsilon);
+				if (!Difference.IsEmpty()) return Fail(TEXT("UHitboxWorldSubsystem hit processing"), AttackerIndex, DefenderIndex, Difference);
+			}
+		}
+
+		for (const int32 Id : Ids)
+		{
+			Subsystem->UnregisterParticipant(Id);
+		}
+
+		// ------------------------------------------
+		// Mass collision processor (per agent totals, the processor keeps no pair results)
+		// ------------------------------------------
+		MassEntities.Reset();
+		{
+			TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager.BatchCreateEntities(MassArchetype, MassSharedValues, NumAgents, MassEntities);
+			for (int32 Index = 0; Index < NumAgents; ++Index)
+			{
+				FHitboxAnimationFragment& Animation = EntityManager.GetFragmentDataChecked<FHitboxAnimationFragment>(MassEntities[Index]);
+				Animation.AnimationIndex = 0;
+				Animation.FrameIndex = Index;
+
+				FHitboxTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FHitboxTransformFragment>(MassEntities[Index]);
+				Transform.Position = Agents[Index].Position;
+				Transform.bFlipX = Agents[Index].bFlipX;
+				Transform.Scale = Agents[Index].Scale;
+			}
+		}
+
+		for (UMassProcessor* Processor : { (UMassProcessor*)MassTransformProcessor, (UMassProcessor*)MassCollisionProcessor })
+		{
+			FMassProcessingContext ProcessingContext(EntityManager, 1.0f / 60.0f);
+			UE::Mass::Executor::Run(*Processor, ProcessingContext);
+		}
+
+		for (int32 DefenderIndex = 0; DefenderIndex < NumAgents; ++DefenderIndex)
+		{
+			int32 HitCount = 0;
+			int32 Damage = 0;
+			int32 Knockback = 0;
+			for (int32 AttackerIndex = 0; AttackerIndex < NumAgents; ++AttackerIndex)
+			{
+				if (AttackerIndex == DefenderIndex) continue;
+
+				ReferenceCheck(Agents[AttackerIndex], Agents[DefenderIndex], Expected);
+				HitCount += Expected.Num();
+				for (const FHitboxCollisionResult& Result : Expected)
+				{
+					Damage += Result.Damage;
+					Knockback = FMath::Max(Knockback, Result.Knockback);
+				}
+			}
+
+			const FHitboxDamageFragment& Taken = EntityManager.GetFragmentDataChecked<FHitboxDamageFragment>(MassEntities[DefenderIndex]);
+			if (Taken.HitCount != HitCount || Taken.Damage != Damage || Taken.Knockback != Knockback)
+			{
+				return Fail(TEXT("UHitboxCollisionProcessor"), DefenderIndex, DefenderIndex, FString::Printf(TEXT("hits %d damage %d knockback %d, expected %d %d %d"),
+					Taken.HitCount, Taken.Damage, Taken.Knockback, HitCount, Damage, Knockback));
+			}
+		}
+
+		EntityManager.BatchDestroyEntities(MassEntities);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("HitboxOracle: %d cases, %lld pairs, %lld reference hits, no divergence (%.1f s)"),
+		Cases, PairsChecked, ExpectedHits, FPlatformTime::Seconds() - StartTime);
+	return 0;
+}
@@ -0,0 +1,184 @@
+#include "HitboxReplayCommandlet.h"
+#include "HitboxBenchmarkUtils.h"
+#include "HitboxCapture.h"
+#include "HitboxDataAsset.h"
+#include "HitboxWorldSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "HAL/PlatformProperties.h"
+#include "HAL/PlatformTime.h"
+
+namespace HitboxReplay
+{
+	/** One replay of the whole capture */
+	struct FPass
+	{
+		double Seconds = 0.0;
+		int64 Allocations = 0;
+		int64 Hits = 0;
+		uint64 Checksum = 0;
+	};
+}
+
+UHitboxReplayCommandlet::UHitboxReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UHitboxReplayCommandlet::Main(const FString& Params)
+{
+	using namespace HitboxReplay;
+
+	FString CapturePath;
+	int32 NumPasses = 3;
+	FString OutputPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("HitboxReplay.json"));
+	FParse::Value(*Params, TEXT("Capture="), CapturePath);
+	FParse::Value(*Params, TEXT("Passes="), NumPasses);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	NumPasses = FMath::Max(NumPasses, 1);
+
+	// ==========================================
+	// LOAD
+	// ==========================================
+
+	FHitboxCapture Capture;
+	if (CapturePath.IsEmpty() || !Capture.Load(CapturePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HitboxReplay: could not read capture '%s' (pass -Capture=<file>)"), *CapturePath);
+		return 1;
+	}
+
+	TArray<UHitboxDataAsset*> Assets;
+	for (const FString& Path : Capture.AssetPaths)
+	{
+		UHitboxDataAsset* Asset = Path.IsEmpty() ? nullptr : LoadObject<UHitboxDataAsset>(nullptr, *Path);
+		if (!Path.IsEmpty() && !Asset)
+		{
+			UE_LOG(LogTemp, Error, TEXT("HitboxReplay: could not load hitbox asset '%s'"), *Path);
+			return 1;
+		}
+		Assets.Add(Asset);
+	}
+
+	// Validate up front so the timed loop needs no checks
+	int32 NumRecords = 0;
+	int32 PeakParticipants = 0;
+	{
+		TSet<int32> Live;
+		for (const FHitboxCaptureTick& Tick : Capture.Ticks)
+		{
+			for (const int32 Id : Tick.Removed)
+			{
+				Live.Remove(Id);
+			}
+			for (const FHitboxCaptureRecord& Record : Tick.Changed)
+			{
+				if (Record.bRegistered && (!Assets.IsValidIndex(Record.AssetIndex) || !Assets[Record.AssetIndex]))
+				{
+					UE_LOG(LogTemp, Error, TEXT("HitboxReplay: participant %d refers to asset %d, which the capture has no path for"), Record.Id, Record.AssetIndex);
+					return 1;
+				}
+				if (!Record.bRegistered && !Live.Contains(Record.Id))
+				{
+					UE_LOG(LogTemp, Error, TEXT("HitboxReplay: participant %d changes before it is registered"), Record.Id);
+					return 1;
+				}
+				Live.Add(Record.Id);
+			}
+			NumRecords += Tick.Changed.Num();
+			PeakParticipants = FMath::Max(PeakParticipants, Live.Num());
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("HitboxReplay: %s - %d ticks, %d assets, %d owners, %d participant changes, peak %d participants"),
+		*CapturePath, Capture.Ticks.Num(), Assets.Num(), Capture.NumOwners, NumRecords, PeakParticipants);
+
+	FHitboxBenchmarkWorld ReplayWorld;
+	UHitboxWorldSubsystem* Subsystem = ReplayWorld.GetSubsystem();
+	if (!Subsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HitboxReplay: no hitbox world subsystem in the replay world"));
+		return 1;
+	}
+
+	FHitboxCaptureReplayer Replayer;
+	Replayer.Init(*Subsystem, Capture, MoveTemp(Assets), PeakParticipants);
+
+	// ==========================================
+	// REPLAY
+	// ==========================================
+
+	TArray<FPass> Passes;
+	FHitboxAllocationCounter AllocationCounter;
+
+	for (int32 PassIndex = 0; PassIndex < NumPasses; ++PassIndex)
+	{
+		FPass& Pass = Passes.AddDefaulted_GetRef();
+		Replayer.Rewind();
+
+		AllocationCounter.Start();
+		const double Start = FPlatformTime::Seconds();
+		Replayer.Replay(Pass.Hits, Pass.Checksum);
+		Pass.Seconds = FPlatformTime::Seconds() - Start;
+		Pass.Allocations = AllocationCounter.Stop();
+	}
+
+	// ==========================================
+	// REPORT
+	// ==========================================
+
+	const int32 NumTicks = FMath::Max(Capture.Ticks.Num(), 1);
+	bool bDeterministic = true;
+	double BestSeconds = TNumericLimits<double>::Max();
+	TArray<TSharedPtr<FJsonValue>> JsonPasses;
+	for (int32 PassIndex = 0; PassIndex < Passes.Num(); ++PassIndex)
+	{
+		const FPass& Pass = Passes[PassIndex];
+		bDeterministic &= Pass.Hits == Passes[0].Hits && Pass.Checksum == Passes[0].Checksum;
+		BestSeconds = FMath::Min(BestSeconds, Pass.Seconds);
+
+		UE_LOG(LogTemp, Display, TEXT("HitboxReplay: pass %d %10.1f ns/tick %6.2f allocs/tick %lld hits checksum %016llx"),
+			PassIndex, Pass.Seconds * 1e9 / NumTicks, double(Pass.Allocations) / NumTicks, Pass.Hits, Pass.Checksum);
+
+		TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetNumberField(TEXT("nsPerTick"), Pass.Seconds * 1e9 / NumTicks);
+		Json->SetNumberField(TEXT("allocationsPerTick"), double(Pass.Allocations) / NumTicks);
+		Json->SetNumberField(TEXT("hits"), (double)Pass.Hits);
+		Json->SetStringField(TEXT("checksum"), FString::Printf(TEXT("%016llx"), Pass.Checksum));
+		JsonPasses.Add(MakeShared<FJsonValueObject>(Json));
+	}
+
+	if (!bDeterministic)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HitboxReplay: passes produced different hits from the same input"));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Root->SetStringField(TEXT("configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Root->SetStringField(TEXT("capture"), CapturePath);
+	Root->SetNumberField(TEXT("ticks"), Capture.Ticks.Num());
+	Root->SetNumberField(TEXT("peakParticipants"), PeakParticipants);
+	Root->SetNumberField(TEXT("bestNsPerTick"), BestSeconds * 1e9 / NumTicks);
+	Root->SetArrayField(TEXT("passes"), JsonPasses);
+
+	FString Output;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root, Writer);
+	if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HitboxReplay: could not write '%s'"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("HitboxReplay: wrote %s"), *OutputPath);
+
+	return bDeterministic ? 0 : 1;
+}
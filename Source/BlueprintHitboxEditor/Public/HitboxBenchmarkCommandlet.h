@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UObject/CoreNet.h"
+#include "HitboxBenchmarkCommandlet.generated.h"
+
+/**
+ * Times the collision paths over synthetic scenarios (1v1, 4v4, 300-enemy horde, 50-box boss)
+ * and writes the results as JSON. Runs headless:
+ *
+ *   UnrealEditor-Cmd <Project> -run=HitboxBenchmark -nullrhi [-Iterations=N] [-Seed=N] [-Scenario=Name]
+ *       [-Output=Path.json] [-Baseline=Path.json] [-Tolerance=0.1]
+ *
+ * With -Baseline, returns 1 when any timing is slower than the baseline by more than Tolerance,
+ * or when allocations per tick went up.
+ *
+ * The world subsystem path also reports replicated state and hit bandwidth, measured with FNetBitWriter.
+ */
+UCLASS()
+class UHitboxBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
+
+/**
+ * Package map for measuring replicated sizes without a connection.
+ * Objects are written as packed indices, the size of a network GUID the receiver already knows.
+ */
+UCLASS(Transient)
+class UHitboxBenchmarkPackageMap : public UPackageMap
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID = nullptr) override;
+
+private:
+	TMap<const UObject*, uint32> ObjectIndices;
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HitboxTypes.h"
+#include "HitboxSnapshot.h"
+#include "HAL/MemoryBase.h"
+
+class UWorld;
+class AActor;
+class UHitboxWorldSubsystem;
+class UHitboxDataAsset;
+struct FHitboxCapture;
+
+/**
+ * Two teams facing each other; team A on the left facing right
+ */
+struct FHitboxBenchmarkScenario
+{
+	const TCHAR* Name;
+	int32 NumA;
+	int32 AttackBoxesA;
+	int32 HurtBoxesA;
+	float SizeA;
+	int32 NumB;
+	int32 AttackBoxesB;
+	int32 HurtBoxesB;
+	float SizeB;
+	float Spread;
+};
+
+/**
+ * One agent of a scenario; FrameIndex is its first frame in the scenario asset's only animation
+ */
+struct FHitboxBenchmarkAgent
+{
+	int32 Team;
+	int32 FrameIndex;
+	FVector2D Position;
+	bool bFlipX;
+	float Scale;
+};
+
+/**
+ * Synthetic data for the hitbox commandlets and automation tests
+ */
+struct BLUEPRINTHITBOXEDITOR_API FHitboxBenchmarkUtils
+{
+	/**
+	 * Make a random frame around the origin: hurtboxes over a body, attack boxes reaching in front of it
+	 * @param Random Stream the boxes are drawn from
+	 * @param NumAttack Number of attack boxes
+	 * @param NumHurt Number of hurtboxes
+	 * @param Size Scale of the body the boxes are placed on (1 = roughly 60x120 units)
+	 */
+	static FFrameHitboxData MakeFrame(FRandomStream& Random, int32 NumAttack, int32 NumHurt, float Size = 1.0f);
+
+	/** 1v1, 4v4, Horde (one player against 300 enemies) and Boss (a 50-box frame against four players) */
+	static TConstArrayView<FHitboxBenchmarkScenario> GetScenarios();
+
+	/** Find a scenario by name (case-insensitive), or nullptr */
+	static const FHitboxBenchmarkScenario* FindScenario(const FString& Name);
+
+	/**
+	 * Make a scenario's transient asset: one animation, frames 0-3 for team A and 4-7 for team B
+	 * so consecutive ticks don't hit the same boxes. Draw it before the agents, from the same stream.
+	 */
+	static UHitboxDataAsset* MakeScenarioAsset(const FHitboxBenchmarkScenario& Scenario, FRandomStream& Random);
+
+	/** Place a scenario's agents: team A (1) on the left half of Spread, team B (2) on the right */
+	static TArray<FHitboxBenchmarkAgent> MakeScenarioAgents(const FHitboxBenchmarkScenario& Scenario, FRandomStream& Random);
+
+	/** Frame index of an agent after a number of ticks; frames advance every tick within the agent's team, like animations would */
+	static int32 GetAgentFrameIndex(const FHitboxBenchmarkAgent& Agent, int32 Tick)
+	{
+		const int32 Base = Agent.FrameIndex < 4 ? 0 : 4;
+		return Base + (Agent.FrameIndex - Base + Tick) % 4;
+	}
+};
+
+/**
+ * Counts allocations made on the thread that started it, by forwarding GMalloc while running.
+ * Other threads keep allocating through it unchanged, they are just not counted.
+ */
+class BLUEPRINTHITBOXEDITOR_API FHitboxAllocationCounter final : public FMalloc
+{
+public:
+	FHitboxAllocationCounter();
+	virtual ~FHitboxAllocationCounter();
+
+	/** Install in front of GMalloc and reset the count */
+	void Start();
+
+	/** Restore GMalloc; returns the number of allocations since Start */
+	int64 Stop();
+
+	// FMalloc interface
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override;
+	virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override;
+	virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override;
+	virtual void Free(void* Original) override;
+	virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override;
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override;
+	virtual void Trim(bool bTrimThreadCaches) override;
+	virtual void SetupTLSCachesOnCurrentThread() override;
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+	virtual bool IsInternallyThreadSafe() const override;
+	virtual const TCHAR* GetDescriptiveName() override { return TEXT("HitboxAllocationCounter"); }
+
+private:
+	FMalloc* Inner = nullptr;
+	uint32 ThreadId = 0;
+	int64 NumAllocations = 0;
+
+	void Count(SIZE_T Size)
+	{
+		if (Size > 0 && FPlatformTLS::GetCurrentThreadId() == ThreadId)
+		{
+			++NumAllocations;
+		}
+	}
+};
+
+/**
+ * Game world created for a commandlet, so the hitbox world subsystem runs without a map or viewport
+ */
+class BLUEPRINTHITBOXEDITOR_API FHitboxBenchmarkWorld
+{
+public:
+	FHitboxBenchmarkWorld();
+	~FHitboxBenchmarkWorld();
+
+	UWorld* GetWorld() const { return World; }
+	UHitboxWorldSubsystem* GetSubsystem() const;
+
+private:
+	UWorld* World = nullptr;
+};
+
+/**
+ * Feeds a loaded capture through a world subsystem, one AdvanceSimulation per captured tick.
+ * Capture ids are mapped to the ids the subsystem hands out, and every replay starts from the state saved in Init,
+ * so passes repeat exactly and Reduced participants are throttled on the same ticks as in the captured session.
+ */
+class BLUEPRINTHITBOXEDITOR_API FHitboxCaptureReplayer
+{
+public:
+	/**
+	 * Apply the capture's settings to the subsystem, spawn its owners and save the state every replay starts from
+	 * @param InAssets Loaded assets by capture asset index
+	 * @param PeakParticipants Most participants alive at once, to size the id maps up front
+	 */
+	void Init(UHitboxWorldSubsystem& InSubsystem, const FHitboxCapture& InCapture, TArray<UHitboxDataAsset*> InAssets, int32 PeakParticipants);
+
+	/** Go back to the state saved in Init */
+	void Rewind();
+
+	/** Replay every captured tick once, adding the hits found and their checksum */
+	void Replay(int64& OutHits, uint64& OutChecksum);
+
+	/** Contribution of one hit to a checksum; summed rather than chained, so hit order doesn't change the result */
+	static uint32 HashHit(const FHitboxHitEvent& Hit, int32 AttackerCaptureId, int32 DefenderCaptureId);
+
+private:
+	UHitboxWorldSubsystem* Subsystem = nullptr;
+	const FHitboxCapture* Capture = nullptr;
+	TArray<UHitboxDataAsset*> Assets;
+	TArray<AActor*> Owners;
+	FHitboxWorldSnapshot InitialState;
+
+	/** Turns a captured tier phase into one for the replay's tick counter */
+	uint32 TierPhaseOffset = 0;
+	uint32 ReducedUpdateInterval = 1;
+
+	TMap<int32, int32> CaptureToReplay;
+	TMap<int32, int32> ReplayToCapture;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HitboxOracleCommandlet.generated.h"
+
+/**
+ * Differential test of every optimized collision path against a frozen copy of the brute-force
+ * CheckHitboxCollision (copied hitbox arrays, per-pair transforms, inclusive FBox2D::Intersect,
+ * attack-major result order). Generated frames favor touching edges, zero-size boxes, flips and scales.
+ *
+ *   UnrealEditor-Cmd <Project> -run=HitboxOracle -nullrhi [-Cases=100000] [-Seed=0] [-WorldEvery=16] [-Epsilon=0]
+ *
+ * Every WorldEvery-th case also runs through world subsystem hit processing (pair results) and the Mass
+ * collision processor (per-agent hit count, summed damage and highest knockback).
+ *
+ * Every case is generated from its own seed; the first mismatch is logged with the command
+ * that reproduces just that case, and the commandlet returns 1.
+ */
+UCLASS()
+class UHitboxOracleCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxOracleCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HitboxReplayCommandlet.generated.h"
+
+/**
+ * Feeds a capture recorded with hitbox.Capture.Start back through world hit processing as fast as possible,
+ * so production workloads can be profiled and implementations compared offline:
+ *
+ *   UnrealEditor-Cmd <Project> -run=HitboxReplay -nullrhi -Capture=Path.hbxcap [-Passes=3] [-Output=Path.json]
+ *
+ * Every pass replays the whole capture in a fresh set of participants and reports time and allocations
+ * per tick, hit count and an order-independent hit checksum that matches between equivalent implementations.
+ */
+UCLASS()
+class UHitboxReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,16 @@
+using UnrealBuildTool;
+
+public class BlueprintHitboxInsights : ModuleRules
+{
+	public BlueprintHitboxInsights(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Loaded by Unreal Insights as well as the editor, so no engine dependencies
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"TraceAnalysis",
+			"TraceServices"
+		});
+	}
+}
@@ -0,0 +1,18 @@
+#include "BlueprintHitboxInsightsModule.h"
+#include "Features/IModularFeatures.h"
+
+#define LOCTEXT_NAMESPACE "FBlueprintHitboxInsightsModule"
+
+void FBlueprintHitboxInsightsModule::StartupModule()
+{
+	IModularFeatures::Get().RegisterModularFeature(TraceServices::ModuleFeatureName, &TraceModule);
+}
+
+void FBlueprintHitboxInsightsModule::ShutdownModule()
+{
+	IModularFeatures::Get().UnregisterModularFeature(TraceServices::ModuleFeatureName, &TraceModule);
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FBlueprintHitboxInsightsModule, BlueprintHitboxInsights)
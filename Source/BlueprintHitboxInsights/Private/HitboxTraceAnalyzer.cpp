@@ -0,0 +1,88 @@
+#include "HitboxTraceAnalyzer.h"
+#include "HitboxTraceProvider.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+FHitboxTraceAnalyzer::FHitboxTraceAnalyzer(TraceServices::IAnalysisSession& InSession, FHitboxTraceProvider& InProvider)
+	: Session(InSession)
+	, Provider(InProvider)
+{
+}
+
+void FHitboxTraceAnalyzer::OnAnalysisBegin(const FOnAnalysisContext& Context)
+{
+	FInterfaceBuilder& Builder = Context.InterfaceBuilder;
+	Builder.RouteEvent(RouteId_Asset, "Hitbox", "Asset");
+	Builder.RouteEvent(RouteId_Tick, "Hitbox", "Tick");
+	Builder.RouteEvent(RouteId_Participant, "Hitbox", "Participant");
+	Builder.RouteEvent(RouteId_Attack, "Hitbox", "Attack");
+	Builder.RouteEvent(RouteId_Hit, "Hitbox", "Hit");
+}
+
+bool FHitboxTraceAnalyzer::OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context)
+{
+	TraceServices::FAnalysisSessionEditScope EditScope(Session);
+
+	const FEventData& EventData = Context.EventData;
+	switch (RouteId)
+	{
+	case RouteId_Asset:
+	{
+		FString Name;
+		EventData.GetString("Name", Name);
+		Provider.SetAssetName(EventData.GetValue<int32>("AssetIndex"), Name);
+		break;
+	}
+	case RouteId_Tick:
+	{
+		FHitboxTraceTick Tick;
+		Tick.Time = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("Cycle"));
+		Tick.SimulationTime = EventData.GetValue<double>("SimulationTime");
+		Tick.TickCounter = EventData.GetValue<uint32>("TickCounter");
+		Tick.NumParticipants = EventData.GetValue<uint32>("NumParticipants");
+		Tick.NumHurtboxes = EventData.GetValue<uint32>("NumHurtboxes");
+		Provider.AddTick(Tick);
+		Session.UpdateDurationSeconds(Tick.Time);
+		break;
+	}
+	case RouteId_Participant:
+	{
+		const uint8 Flags = EventData.GetValue<uint8>("Flags");
+
+		FHitboxTraceParticipant Participant;
+		Participant.Id = EventData.GetValue<int32>("Id");
+		Participant.AssetIndex = EventData.GetValue<int16>("AssetIndex");
+		Participant.AnimationIndex = EventData.GetValue<int16>("AnimationIndex");
+		Participant.FrameIndex = EventData.GetValue<int16>("FrameIndex");
+		Participant.Position = FVector2f(EventData.GetValue<float>("X"), EventData.GetValue<float>("Y"));
+		Participant.Scale = EventData.GetValue<float>("Scale");
+		Participant.bFlipX = (Flags & 1) != 0;
+		Participant.bAttackActive = (Flags & 2) != 0;
+		Participant.Tier = (Flags >> 2) & 3;
+		Provider.AddParticipant(Participant);
+		break;
+	}
+	case RouteId_Attack:
+	{
+		FHitboxTraceAttack Attack;
+		Attack.AttackerId = EventData.GetValue<int32>("AttackerId");
+		Attack.AttackId = EventData.GetValue<int32>("AttackId");
+		Attack.AttackHitboxIndex = EventData.GetValue<int16>("AttackHitboxIndex");
+		Attack.NumCandidates = EventData.GetValue<uint16>("NumCandidates");
+		Provider.AddAttack(Attack);
+		break;
+	}
+	case RouteId_Hit:
+	{
+		FHitboxTraceHit Hit;
+		Hit.AttackerId = EventData.GetValue<int32>("AttackerId");
+		Hit.DefenderId = EventData.GetValue<int32>("DefenderId");
+		Hit.AttackHitboxIndex = EventData.GetValue<int16>("AttackHitboxIndex");
+		Hit.HurtHitboxIndex = EventData.GetValue<int16>("HurtHitboxIndex");
+		Hit.Damage = EventData.GetValue<int32>("Damage");
+		Provider.AddHit(Hit);
+		break;
+	}
+	}
+
+	return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Analyzer.h"
+
+namespace TraceServices { class IAnalysisSession; }
+class FHitboxTraceProvider;
+
+/**
+ * Reads the Hitbox logger's Asset, Tick, Participant, Attack and Hit events into FHitboxTraceProvider
+ */
+class FHitboxTraceAnalyzer : public UE::Trace::IAnalyzer
+{
+public:
+	FHitboxTraceAnalyzer(TraceServices::IAnalysisSession& InSession, FHitboxTraceProvider& InProvider);
+
+	virtual void OnAnalysisBegin(const FOnAnalysisContext& Context) override;
+	virtual bool OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context) override;
+
+private:
+	enum : uint16
+	{
+		RouteId_Asset,
+		RouteId_Tick,
+		RouteId_Participant,
+		RouteId_Attack,
+		RouteId_Hit,
+	};
+
+	TraceServices::IAnalysisSession& Session;
+	FHitboxTraceProvider& Provider;
+};
@@ -0,0 +1,73 @@
+#include "HitboxTraceModule.h"
+#include "HitboxTraceAnalyzer.h"
+#include "HitboxTraceProvider.h"
+#include "TraceServices/Model/AnalysisSession.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static const FName HitboxTraceModuleName("TraceModule_Hitbox");
+
+void FHitboxTraceModule::GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo)
+{
+	OutModuleInfo.Name = HitboxTraceModuleName;
+	OutModuleInfo.DisplayName = TEXT("Hitbox");
+}
+
+void FHitboxTraceModule::OnAnalysisBegin(TraceServices::IAnalysisSession& Session)
+{
+	TSharedPtr<FHitboxTraceProvider> Provider = MakeShared<FHitboxTraceProvider>(Session);
+	Session.AddProvider(FHitboxTraceProvider::ProviderName, Provider);
+	Session.AddAnalyzer(new FHitboxTraceAnalyzer(Session, *Provider));
+}
+
+void FHitboxTraceModule::GetLoggers(TArray<const TCHAR*>& OutLoggers)
+{
+	OutLoggers.Add(TEXT("Hitbox"));
+}
+
+void FHitboxTraceModule::GenerateReports(const TraceServices::IAnalysisSession& Session, const TCHAR* CmdLine, const TCHAR* OutputDirectory)
+{
+	TraceServices::FAnalysisSessionReadScope ReadScope(Session);
+
+	const FHitboxTraceProvider* Provider = ReadHitboxTraceProvider(Session);
+	if (!Provider || Provider->GetTicks().Num() == 0) return;
+
+	// One row per tick, then one row per hit, so spikes can be matched to the moves that caused them
+	TArray<FString> TickLines;
+	TickLines.Add(TEXT("Time,TickCounter,SimulationTime,Participants,Hurtboxes,AttackBoxes,CandidatePairs,Hits"));
+
+	TArray<FString> HitLines;
+	HitLines.Add(TEXT("Time,TickCounter,AttackerId,AttackerAsset,AttackerAnimation,AttackerFrame,AttackHitboxIndex,DefenderId,HurtHitboxIndex,Damage"));
+
+	for (const FHitboxTraceTick& Tick : Provider->GetTicks())
+	{
+		int32 CandidatePairs = 0;
+		for (const FHitboxTraceAttack& Attack : Provider->GetAttacks(Tick))
+		{
+			CandidatePairs += Attack.NumCandidates;
+		}
+
+		TickLines.Add(FString::Printf(TEXT("%.6f,%u,%.6f,%u,%u,%d,%d,%d"),
+			Tick.Time, Tick.TickCounter, Tick.SimulationTime, Tick.NumParticipants, Tick.NumHurtboxes,
+			Tick.NumAttacks, CandidatePairs, Tick.NumHits));
+
+		const TConstArrayView<FHitboxTraceParticipant> Participants = Provider->GetParticipants(Tick);
+		for (const FHitboxTraceHit& Hit : Provider->GetHits(Tick))
+		{
+			const FHitboxTraceParticipant* Attacker = Participants.FindByPredicate([&Hit](const FHitboxTraceParticipant& Participant)
+			{
+				return Participant.Id == Hit.AttackerId;
+			});
+
+			HitLines.Add(FString::Printf(TEXT("%.6f,%u,%d,%s,%d,%d,%d,%d,%d,%d"),
+				Tick.Time, Tick.TickCounter, Hit.AttackerId,
+				Attacker ? *Provider->GetAssetName(Attacker->AssetIndex) : TEXT(""),
+				Attacker ? Attacker->AnimationIndex : INDEX_NONE,
+				Attacker ? Attacker->FrameIndex : INDEX_NONE,
+				Hit.AttackHitboxIndex, Hit.DefenderId, Hit.HurtHitboxIndex, Hit.Damage));
+		}
+	}
+
+	FFileHelper::SaveStringArrayToFile(TickLines, *FPaths::Combine(OutputDirectory, TEXT("HitboxTicks.csv")));
+	FFileHelper::SaveStringArrayToFile(HitLines, *FPaths::Combine(OutputDirectory, TEXT("HitboxHits.csv")));
+}
@@ -0,0 +1,104 @@
+#include "HitboxTraceProvider.h"
+#include "Algo/BinarySearch.h"
+
+const FName FHitboxTraceProvider::ProviderName("HitboxTraceProvider");
+
+FHitboxTraceProvider::FHitboxTraceProvider(TraceServices::IAnalysisSession& InSession)
+	: Session(InSession)
+{
+}
+
+// ==========================================
+// WRITE (analyzer)
+// ==========================================
+
+void FHitboxTraceProvider::SetAssetName(int32 AssetIndex, const FString& Name)
+{
+	Session.WriteAccessCheck();
+	AssetNames.Add(AssetIndex, Name);
+}
+
+void FHitboxTraceProvider::AddTick(const FHitboxTraceTick& Tick)
+{
+	Session.WriteAccessCheck();
+
+	FHitboxTraceTick& Added = Ticks.Add_GetRef(Tick);
+	Added.FirstParticipant = Participants.Num();
+	Added.NumParticipantStates = 0;
+	Added.FirstAttack = Attacks.Num();
+	Added.NumAttacks = 0;
+	Added.FirstHit = Hits.Num();
+	Added.NumHits = 0;
+}
+
+void FHitboxTraceProvider::AddParticipant(const FHitboxTraceParticipant& Participant)
+{
+	Session.WriteAccessCheck();
+	if (Ticks.Num() == 0) return;
+
+	Participants.Add(Participant);
+	Ticks.Last().NumParticipantStates++;
+}
+
+void FHitboxTraceProvider::AddAttack(const FHitboxTraceAttack& Attack)
+{
+	Session.WriteAccessCheck();
+	if (Ticks.Num() == 0) return;
+
+	Attacks.Add(Attack);
+	Ticks.Last().NumAttacks++;
+}
+
+void FHitboxTraceProvider::AddHit(const FHitboxTraceHit& Hit)
+{
+	Session.WriteAccessCheck();
+	if (Ticks.Num() == 0) return;
+
+	Hits.Add(Hit);
+	Ticks.Last().NumHits++;
+}
+
+// ==========================================
+// READ
+// ==========================================
+
+TConstArrayView<FHitboxTraceParticipant> FHitboxTraceProvider::GetParticipants(const FHitboxTraceTick& Tick) const
+{
+	Session.ReadAccessCheck();
+	return MakeArrayView(Participants.GetData() + Tick.FirstParticipant, Tick.NumParticipantStates);
+}
+
+TConstArrayView<FHitboxTraceAttack> FHitboxTraceProvider::GetAttacks(const FHitboxTraceTick& Tick) const
+{
+	Session.ReadAccessCheck();
+	return MakeArrayView(Attacks.GetData() + Tick.FirstAttack, Tick.NumAttacks);
+}
+
+TConstArrayView<FHitboxTraceHit> FHitboxTraceProvider::GetHits(const FHitboxTraceTick& Tick) const
+{
+	Session.ReadAccessCheck();
+	return MakeArrayView(Hits.GetData() + Tick.FirstHit, Tick.NumHits);
+}
+
+const FString& FHitboxTraceProvider::GetAssetName(int32 AssetIndex) const
+{
+	Session.ReadAccessCheck();
+
+	static const FString Empty;
+	const FString* Name = AssetNames.Find(AssetIndex);
+	return Name ? *Name : Empty;
+}
+
+int32 FHitboxTraceProvider::FindTickAtTime(double Time) const
+{
+	Session.ReadAccessCheck();
+
+	// Ticks arrive in time order
+	const int32 Upper = Algo::UpperBoundBy(Ticks, Time, &FHitboxTraceTick::Time);
+	return Upper - 1;
+}
+
+const FHitboxTraceProvider* ReadHitboxTraceProvider(const TraceServices::IAnalysisSession& Session)
+{
+	return Session.ReadProvider<FHitboxTraceProvider>(FHitboxTraceProvider::ProviderName);
+}
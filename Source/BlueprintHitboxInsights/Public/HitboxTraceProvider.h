@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+/** One processed world tick and the range of its records in the provider */
+struct FHitboxTraceTick
+{
+	double Time = 0.0;
+	double SimulationTime = 0.0;
+	uint32 TickCounter = 0;
+	uint32 NumParticipants = 0;
+	uint32 NumHurtboxes = 0;
+
+	int32 FirstParticipant = 0;
+	int32 NumParticipantStates = 0;
+	int32 FirstAttack = 0;
+	int32 NumAttacks = 0;
+	int32 FirstHit = 0;
+	int32 NumHits = 0;
+};
+
+/** Participant state at the start of a tick; AssetIndex/AnimationIndex/FrameIndex form the frame handle */
+struct FHitboxTraceParticipant
+{
+	int32 Id = INDEX_NONE;
+	int32 AssetIndex = INDEX_NONE;
+	int32 AnimationIndex = INDEX_NONE;
+	int32 FrameIndex = INDEX_NONE;
+	FVector2f Position = FVector2f::ZeroVector;
+	float Scale = 1.0f;
+	uint8 Tier = 0;
+	bool bFlipX = false;
+	bool bAttackActive = false;
+};
+
+/** An attack box and the number of candidate hurtboxes the grid returned for it */
+struct FHitboxTraceAttack
+{
+	int32 AttackerId = INDEX_NONE;
+	int32 AttackId = INDEX_NONE;
+	int32 AttackHitboxIndex = INDEX_NONE;
+	int32 NumCandidates = 0;
+};
+
+struct FHitboxTraceHit
+{
+	int32 AttackerId = INDEX_NONE;
+	int32 DefenderId = INDEX_NONE;
+	int32 AttackHitboxIndex = INDEX_NONE;
+	int32 HurtHitboxIndex = INDEX_NONE;
+	int32 Damage = 0;
+};
+
+/**
+ * Hitbox channel data of an analysis session.
+ * Read under TraceServices::FAnalysisSessionReadScope; records of a tick are contiguous.
+ */
+class BLUEPRINTHITBOXINSIGHTS_API FHitboxTraceProvider : public TraceServices::IProvider
+{
+public:
+	static const FName ProviderName;
+
+	explicit FHitboxTraceProvider(TraceServices::IAnalysisSession& InSession);
+
+	// ==========================================
+	// WRITE (analyzer)
+	// ==========================================
+
+	void SetAssetName(int32 AssetIndex, const FString& Name);
+	void AddTick(const FHitboxTraceTick& Tick);
+	void AddParticipant(const FHitboxTraceParticipant& Participant);
+	void AddAttack(const FHitboxTraceAttack& Attack);
+	void AddHit(const FHitboxTraceHit& Hit);
+
+	// ==========================================
+	// READ
+	// ==========================================
+
+	TConstArrayView<FHitboxTraceTick> GetTicks() const { return Ticks; }
+	TConstArrayView<FHitboxTraceParticipant> GetParticipants(const FHitboxTraceTick& Tick) const;
+	TConstArrayView<FHitboxTraceAttack> GetAttacks(const FHitboxTraceTick& Tick) const;
+	TConstArrayView<FHitboxTraceHit> GetHits(const FHitboxTraceTick& Tick) const;
+
+	/** Asset path for an asset index, or empty if its Asset event wasn't recorded */
+	const FString& GetAssetName(int32 AssetIndex) const;
+
+	/** Index of the last tick at or before Time, or -1 */
+	int32 FindTickAtTime(double Time) const;
+
+private:
+	TraceServices::IAnalysisSession& Session;
+
+	TArray<FHitboxTraceTick> Ticks;
+	TArray<FHitboxTraceParticipant> Participants;
+	TArray<FHitboxTraceAttack> Attacks;
+	TArray<FHitboxTraceHit> Hits;
+	TMap<int32, FString> AssetNames;
+};
+
+/** Get the hitbox provider of a session, or nullptr if the module wasn't active for it */
+BLUEPRINTHITBOXINSIGHTS_API const FHitboxTraceProvider* ReadHitboxTraceProvider(const TraceServices::IAnalysisSession& Session);
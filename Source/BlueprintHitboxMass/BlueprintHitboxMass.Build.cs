@@ -0,0 +1,18 @@
+using UnrealBuildTool;
+
+public class BlueprintHitboxMass : ModuleRules
+{
+	public BlueprintHitboxMass(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"BlueprintHitbox",
+			"MassEntity",
+			"MassSpawner"
+		});
+	}
+}
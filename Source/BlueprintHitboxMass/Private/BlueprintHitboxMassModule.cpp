@@ -0,0 +1,15 @@
+#include "BlueprintHitboxMassModule.h"
+
+#define LOCTEXT_NAMESPACE "FBlueprintHitboxMassModule"
+
+void FBlueprintHitboxMassModule::StartupModule()
+{
+}
+
+void FBlueprintHitboxMassModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FBlueprintHitboxMassModule, BlueprintHitboxMass)
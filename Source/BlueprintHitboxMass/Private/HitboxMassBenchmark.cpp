@@ -0,0 +1,72 @@
+#include "HitboxMassFragments.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Spawns a crowd of hitbox agents into the current world for scaling tests.
+ * Run in any map (an empty one with -nullrhi works for headless runs) and profile the Hitbox processor group.
+ */
+static FAutoConsoleCommandWithWorldAndArgs HitboxMassSpawnBenchmarkCommand(
+	TEXT("hitbox.Mass.SpawnBenchmark"),
+	TEXT("Spawn hitbox Mass agents. Usage: hitbox.Mass.SpawnBenchmark <AssetPath> [Count=10000] [Extent=20000] [Seed=0]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || Args.Num() < 1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("hitbox.Mass.SpawnBenchmark: missing world or asset path"));
+			return;
+		}
+
+		UHitboxDataAsset* Asset = LoadObject<UHitboxDataAsset>(nullptr, *Args[0]);
+		UMassEntitySubsystem* EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+		if (!Asset || Asset->Animations.Num() == 0 || !EntitySubsystem)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("hitbox.Mass.SpawnBenchmark: could not load hitbox asset '%s' or Mass is unavailable"), *Args[0]);
+			return;
+		}
+
+		const int32 Count = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10000;
+		const float Extent = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 20000.0f;
+		FRandomStream Random(Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 0);
+
+		FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+		const FMassArchetypeHandle Archetype = EntityManager.CreateArchetype({
+			FHitboxAnimationFragment::StaticStruct(),
+			FHitboxTransformFragment::StaticStruct(),
+			FHitboxTeamFragment::StaticStruct(),
+			FHitboxBoundsFragment::StaticStruct(),
+			FHitboxDamageFragment::StaticStruct()
+		});
+
+		FHitboxAssetFragment AssetFragment;
+		AssetFragment.Asset = Asset;
+
+		FMassArchetypeSharedFragmentValues SharedValues;
+		SharedValues.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(AssetFragment));
+		SharedValues.Sort();
+
+		TArray<FMassEntityHandle> Entities;
+		{
+			TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager.BatchCreateEntities(Archetype, SharedValues, Count, Entities);
+
+			for (const FMassEntityHandle Entity : Entities)
+			{
+				FHitboxAnimationFragment& Animation = EntityManager.GetFragmentDataChecked<FHitboxAnimationFragment>(Entity);
+				Animation.AnimationIndex = Random.RandRange(0, Asset->Animations.Num() - 1);
+				Animation.FrameIndex = Random.RandRange(0, FMath::Max(Asset->Animations[Animation.AnimationIndex].Frames.Num() - 1, 0));
+
+				FHitboxTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FHitboxTransformFragment>(Entity);
+				Transform.Position = FVector2D(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent));
+				Transform.bFlipX = Random.RandRange(0, 1) == 1;
+
+				EntityManager.GetFragmentDataChecked<FHitboxTeamFragment>(Entity).Team = 1 + Random.RandRange(0, 1);
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("hitbox.Mass.SpawnBenchmark: spawned %d agents using '%s'"), Entities.Num(), *Asset->GetName());
+	}),
+	ECVF_Cheat
+);
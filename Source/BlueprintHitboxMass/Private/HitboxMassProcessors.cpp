@@ -0,0 +1,236 @@
+#include "HitboxMassProcessors.h"
+#include "HitboxMassFragments.h"
+#include "HitboxBlueprintLibrary.h"
+#include "MassExecutionContext.h"
+#include "HAL/IConsoleManager.h"
+
+static FName GetHitboxProcessorGroup()
+{
+	static const FName GroupName(TEXT("Hitbox"));
+	return GroupName;
+}
+
+// ==========================================
+// FRAME ADVANCE
+// ==========================================
+
+UHitboxFrameAdvanceProcessor::UHitboxFrameAdvanceProcessor()
+{
+	ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	ExecutionOrder.ExecuteInGroup = GetHitboxProcessorGroup();
+}
+
+void UHitboxFrameAdvanceProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FHitboxAnimationFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FHitboxAssetFragment>();
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UHitboxFrameAdvanceProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& Context)
+	{
+		const FHitboxAssetFragment& AssetFragment = Context.GetConstSharedFragment<FHitboxAssetFragment>();
+		const UHitboxDataAsset* Asset = AssetFragment.Asset;
+		if (!Asset || AssetFragment.FramesPerSecond <= 0.0f) return;
+
+		const float FrameDuration = 1.0f / AssetFragment.FramesPerSecond;
+		const float DeltaTime = Context.GetDeltaTimeSeconds();
+		const TArrayView<FHitboxAnimationFragment> Animations = Context.GetMutableFragmentView<FHitboxAnimationFragment>();
+
+		for (FHitboxAnimationFragment& Animation : Animations)
+		{
+			if (!Asset->Animations.IsValidIndex(Animation.AnimationIndex)) continue;
+
+			const int32 NumFrames = Asset->Animations[Animation.AnimationIndex].Frames.Num();
+			if (NumFrames == 0) continue;
+
+			Animation.FrameTime += DeltaTime;
+			if (Animation.FrameTime < FrameDuration) continue;
+
+			const int32 Steps = FMath::FloorToInt32(Animation.FrameTime / FrameDuration);
+			Animation.FrameTime -= Steps * FrameDuration;
+			Animation.FrameIndex = Animation.bLoop
+				? (Animation.FrameIndex + Steps) % NumFrames
+				: FMath::Min(Animation.FrameIndex + Steps, NumFrames - 1);
+		}
+	});
+}
+
+// ==========================================
+// WORLD TRANSFORM
+// ==========================================
+
+UHitboxWorldTransformProcessor::UHitboxWorldTransformProcessor()
+{
+	ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	ExecutionOrder.ExecuteInGroup = GetHitboxProcessorGroup();
+	ExecutionOrder.ExecuteAfter.Add(UHitboxFrameAdvanceProcessor::StaticClass()->GetFName());
+}
+
+void UHitboxWorldTransformProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FHitboxAnimationFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHitboxTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHitboxBoundsFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FHitboxAssetFragment>();
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UHitboxWorldTransformProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& Context)
+	{
+		const UHitboxDataAsset* Asset = Context.GetConstSharedFragment<FHitboxAssetFragment>().Asset;
+		const TConstArrayView<FHitboxAnimationFragment> Animations = Context.GetFragmentView<FHitboxAnimationFragment>();
+		const TConstArrayView<FHitboxTransformFragment> Transforms = Context.GetFragmentView<FHitboxTransformFragment>();
+		const TArrayView<FHitboxBoundsFragment> Bounds = Context.GetMutableFragmentView<FHitboxBoundsFragment>();
+
+		for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+		{
+			FHitboxBoundsFragment& AgentBounds = Bounds[Index];
+			AgentBounds.AttackBounds = FBox2D(ForceInit);
+			AgentBounds.HurtBounds = FBox2D(ForceInit);
+
+			const FHitboxAnimationFragment& Animation = Animations[Index];
+			const FFrameHitboxData* Frame = Asset ? Asset->GetFramePtr(Animation.AnimationIndex, Animation.FrameIndex) : nullptr;
+			if (!Frame) continue;
+
+			const FHitboxTransformFragment& Transform = Transforms[Index];
+			for (const FHitboxData& Hitbox : Frame->Hitboxes)
+			{
+				if (Hitbox.Type == EHitboxType::Collision) continue;
+
+				const FBox2D World = UHitboxBlueprintLibrary::HitboxToWorldSpace(Hitbox, Transform.Position, Transform.bFlipX, Transform.Scale);
+				if (Hitbox.Type == EHitboxType::Attack)
+				{
+					AgentBounds.AttackBounds += World;
+				}
+				else
+				{
+					AgentBounds.HurtBounds += World;
+				}
+			}
+		}
+	});
+}
+
+// ==========================================
+// COLLISION
+// ==========================================
+
+UHitboxCollisionProcessor::UHitboxCollisionProcessor()
+{
+	ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	ExecutionOrder.ExecuteInGroup = GetHitboxProcessorGroup();
+	ExecutionOrder.ExecuteAfter.Add(UHitboxWorldTransformProcessor::StaticClass()->GetFName());
+}
+
+void UHitboxCollisionProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FHitboxAnimationFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHitboxTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHitboxBoundsFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHitboxTeamFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FHitboxDamageFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FHitboxAssetFragment>();
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UHitboxCollisionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	static const IConsoleVariable* CellSizeVar = IConsoleManager::Get().FindConsoleVariable(TEXT("hitbox.GridCellSize"));
+
+	Agents.Reset();
+	Hurtboxes.Reset();
+	HurtboxGrid.Reset(CellSizeVar ? CellSizeVar->GetFloat() : 256.0f);
+
+	// Pass 1: flatten agents chunk by chunk and index their hurtboxes
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [this](FMassExecutionContext& Context)
+	{
+		const UHitboxDataAsset* Asset = Context.GetConstSharedFragment<FHitboxAssetFragment>().Asset;
+		const TConstArrayView<FHitboxAnimationFragment> Animations = Context.GetFragmentView<FHitboxAnimationFragment>();
+		const TConstArrayView<FHitboxTransformFragment> Transforms = Context.GetFragmentView<FHitboxTransformFragment>();
+		const TConstArrayView<FHitboxBoundsFragment> Bounds = Context.GetFragmentView<FHitboxBoundsFragment>();
+		const TConstArrayView<FHitboxTeamFragment> Teams = Context.GetFragmentView<FHitboxTeamFragment>();
+
+		for (int32 Index = 0; Index < Context.GetNumEntities(); ++Index)
+		{
+			const FHitboxAnimationFragment& Animation = Animations[Index];
+			const FHitboxTransformFragment& Transform = Transforms[Index];
+
+			const int32 AgentIndex = Agents.Add({
+				Asset ? Asset->GetFramePtr(Animation.AnimationIndex, Animation.FrameIndex) : nullptr,
+				Transform.Position,
+				Transform.bFlipX,
+				Transform.Scale,
+				Teams.Num() > 0 ? Teams[Index].Team : 0,
+				Bounds[Index].AttackBounds,
+				0, 0, 0
+			});
+
+			const FFrameHitboxData* Frame = Agents[AgentIndex].Frame;
+			if (!Frame || !Bounds[Index].HurtBounds.bIsValid) continue;
+
+			for (const FHitboxData& Hitbox : Frame->Hitboxes)
+			{
+				if (Hitbox.Type != EHitboxType::Hurtbox) continue;
+
+				HurtboxGrid.Insert(UHitboxBlueprintLibrary::HitboxToWorldSpace(Hitbox, Transform.Position, Transform.bFlipX, Transform.Scale));
+				Hurtboxes.Add({ AgentIndex, &Hitbox });
+			}
+		}
+	});
+
+	// Pass 2: attackers against the grid, over contiguous agent data
+	if (Hurtboxes.Num() > 0)
+	{
+		for (int32 AttackerIndex = 0; AttackerIndex < Agents.Num(); ++AttackerIndex)
+		{
+			const FAgent& Attacker = Agents[AttackerIndex];
+			if (!Attacker.AttackBounds.bIsValid) continue;
+
+			Candidates.Reset();
+			HurtboxGrid.Query(Attacker.AttackBounds, Candidates);
+			if (Candidates.Num() == 0) continue;
+
+			for (const FHitboxData& Attack : Attacker.Frame->Hitboxes)
+			{
+				if (Attack.Type != EHitboxType::Attack) continue;
+
+				const FBox2D AttackWorld = UHitboxBlueprintLibrary::HitboxToWorldSpace(Attack, Attacker.Position, Attacker.bFlipX, Attacker.Scale);
+				for (const int32 Item : Candidates)
+				{
+					const FAgentHurtbox& Hurt = Hurtboxes[Item];
+					if (Hurt.AgentIndex == AttackerIndex) continue;
+
+					FAgent& Defender = Agents[Hurt.AgentIndex];
+					if (Attacker.Team != 0 && Attacker.Team == Defender.Team) continue;
+					if (!AttackWorld.Intersect(HurtboxGrid.GetItemBounds(Item))) continue;
+
+					Defender.HitCount++;
+					Defender.Damage += Attack.Damage;
+					Defender.Knockback = FMath::Max(Defender.Knockback, Attack.Knockback);
+				}
+			}
+		}
+	}
+
+	// Pass 3: write results back, chunks are visited in the same order as pass 1
+	int32 AgentIndex = 0;
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [this, &AgentIndex](FMassExecutionContext& Context)
+	{
+		const TArrayView<FHitboxDamageFragment> Damages = Context.GetMutableFragmentView<FHitboxDamageFragment>();
+		for (FHitboxDamageFragment& Damage : Damages)
+		{
+			const FAgent& Agent = Agents[AgentIndex++];
+			Damage.HitCount = Agent.HitCount;
+			Damage.Damage = Agent.Damage;
+			Damage.Knockback = Agent.Knockback;
+		}
+	});
+}
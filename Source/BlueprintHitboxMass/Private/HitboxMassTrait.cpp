@@ -0,0 +1,16 @@
+#include "HitboxMassTrait.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+
+void UHitboxMassTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+	BuildContext.AddFragment_GetRef<FHitboxAnimationFragment>().AnimationIndex = AnimationIndex;
+	BuildContext.AddFragment_GetRef<FHitboxTeamFragment>().Team = Team;
+	BuildContext.AddFragment<FHitboxTransformFragment>();
+	BuildContext.AddFragment<FHitboxBoundsFragment>();
+	BuildContext.AddFragment<FHitboxDamageFragment>();
+
+	BuildContext.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(HitboxAsset));
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "HitboxDataAsset.h"
+#include "HitboxMassFragments.generated.h"
+
+/**
+ * Hitbox data shared by every agent in a chunk.
+ * Agents using the same asset land in the same chunks, so processors resolve the asset once per chunk.
+ */
+USTRUCT()
+struct BLUEPRINTHITBOXMASS_API FHitboxAssetFragment : public FMassConstSharedFragment
+{
+	GENERATED_BODY()
+
+	/** Hitbox data for these agents */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	TObjectPtr<UHitboxDataAsset> Asset = nullptr;
+
+	/** Playback rate used to advance frames */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	float FramesPerSecond = 12.0f;
+};
+
+/**
+ * Current animation and frame of an agent
+ */
+USTRUCT()
+struct BLUEPRINTHITBOXMASS_API FHitboxAnimationFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** Index into the asset's animations */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	int32 AnimationIndex = 0;
+
+	/** Index into the animation's frames */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	int32 FrameIndex = 0;
+
+	/** Time spent on the current frame */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	float FrameTime = 0.0f;
+
+	/** Wrap to the first frame after the last one (otherwise hold the last frame) */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	bool bLoop = true;
+};
+
+/**
+ * 2D placement of an agent's hitboxes
+ */
+USTRUCT()
+struct BLUEPRINTHITBOXMASS_API FHitboxTransformFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** World position (2D) */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/** Is the agent facing left */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	bool bFlipX = false;
+
+	/** Scale multiplier */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	float Scale = 1.0f;
+};
+
+/**
+ * Team of an agent, agents on the same non-zero team never hit each other
+ */
+USTRUCT()
+struct BLUEPRINTHITBOXMASS_API FHitboxTeamFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	int32 Team = 0;
+};
+
+/**
+ * World-space bounds of the agent's current frame, written by UHitboxWorldTransformProcessor
+ */
+USTRUCT()
+struct BLUEPRINTHITBOXMASS_API FHitboxBoundsFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** Union of all attack boxes (invalid if the frame has none) */
+	UPROPERTY()
+	FBox2D AttackBounds = FBox2D(ForceInit);
+
+	/** Union of all hurtboxes (invalid if the frame has none) */
+	UPROPERTY()
+	FBox2D HurtBounds = FBox2D(ForceInit);
+};
+
+/**
+ * Hits taken by an agent during the last collision pass, written by UHitboxCollisionProcessor
+ */
+USTRUCT()
+struct BLUEPRINTHITBOXMASS_API FHitboxDamageFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** Number of attack/hurtbox overlaps */
+	UPROPERTY()
+	int32 HitCount = 0;
+
+	/** Summed damage, same as GetTotalDamage over the pair results */
+	UPROPERTY()
+	int32 Damage = 0;
+
+	/** Highest knockback, same as GetMaxKnockback over the pair results */
+	UPROPERTY()
+	int32 Knockback = 0;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "HitboxSpatialGrid.h"
+#include "HitboxMassProcessors.generated.h"
+
+struct FHitboxData;
+struct FFrameHitboxData;
+
+/**
+ * Advances each agent's frame at the asset's FramesPerSecond
+ */
+UCLASS()
+class BLUEPRINTHITBOXMASS_API UHitboxFrameAdvanceProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxFrameAdvanceProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * Computes world-space attack and hurt bounds from the current frame and transform
+ */
+UCLASS()
+class BLUEPRINTHITBOXMASS_API UHitboxWorldTransformProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxWorldTransformProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * Tests every agent's attack boxes against all other agents' hurtboxes through a spatial grid
+ * and writes the results into FHitboxDamageFragment.
+ */
+UCLASS()
+class BLUEPRINTHITBOXMASS_API UHitboxCollisionProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UHitboxCollisionProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	/** One agent flattened out of its chunk for the all-pairs pass */
+	struct FAgent
+	{
+		const FFrameHitboxData* Frame;
+		FVector2D Position;
+		bool bFlipX;
+		float Scale;
+		int32 Team;
+		FBox2D AttackBounds;
+		int32 HitCount;
+		int32 Damage;
+		int32 Knockback;
+	};
+
+	/** Hurtbox inserted in the grid; item index in the grid equals index in Hurtboxes */
+	struct FAgentHurtbox
+	{
+		int32 AgentIndex;
+		const FHitboxData* Hitbox;
+	};
+
+	FMassEntityQuery EntityQuery;
+
+	// Scratch buffers kept between executions to avoid reallocating every tick
+	TArray<FAgent> Agents;
+	TArray<FAgentHurtbox> Hurtboxes;
+	TArray<int32> Candidates;
+	FHitboxSpatialGrid HurtboxGrid;
+};
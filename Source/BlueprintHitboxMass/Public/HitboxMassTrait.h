@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "HitboxMassFragments.h"
+#include "HitboxMassTrait.generated.h"
+
+/**
+ * Adds hitbox simulation to a Mass entity config.
+ * Agents get frame advance, world-space bounds and collision against all other hitbox agents.
+ */
+UCLASS(meta = (DisplayName = "Hitbox"))
+class BLUEPRINTHITBOXMASS_API UHitboxMassTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+public:
+	/** Hitbox data and playback rate shared by all agents of this config */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	FHitboxAssetFragment HitboxAsset;
+
+	/** Animation agents start in (index into the asset's animations) */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	int32 AnimationIndex = 0;
+
+	/** Team id, agents on the same non-zero team never hit each other */
+	UPROPERTY(EditAnywhere, Category = "Hitbox")
+	int32 Team = 0;
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
@@ -0,0 +1,17 @@
+using UnrealBuildTool;
+
+public class BlueprintHitboxTests : ModuleRules
+{
+	public BlueprintHitboxTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"BlueprintHitbox",
+			"BlueprintHitboxEditor"
+		});
+	}
+}
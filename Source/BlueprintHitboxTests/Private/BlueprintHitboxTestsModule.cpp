@@ -0,0 +1,4 @@
+#include "Modules/ModuleManager.h"
+
+// Automation tests only; they register themselves when the module loads
+IMPLEMENT_MODULE(FDefaultModuleImpl, BlueprintHitboxTests)
@@ -0,0 +1,118 @@
+#include "HitboxBenchmarkUtils.h"
+#include "HitboxCapture.h"
+#include "HitboxDataAsset.h"
+#include "HitboxWorldSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitboxReplayReducedTiersTest, "Hitbox.Replay.ReducedTiers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * Capture a session with Reduced participants, then replay it twice: both passes have to find exactly the live hits,
+ * although the replay hands out other ids and starts at another tick counter
+ */
+bool FHitboxReplayReducedTiersTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 Ticks = 24;
+	static constexpr float DeltaTime = 1.0f / 60.0f;
+
+	const FHitboxBenchmarkScenario* Scenario = FHitboxBenchmarkUtils::FindScenario(TEXT("4v4"));
+	if (!TestNotNull(TEXT("Scenario"), Scenario)) return false;
+
+	FRandomStream Random(0);
+	UHitboxDataAsset* Asset = FHitboxBenchmarkUtils::MakeScenarioAsset(*Scenario, Random);
+	const TArray<FHitboxBenchmarkAgent> Agents = FHitboxBenchmarkUtils::MakeScenarioAgents(*Scenario, Random);
+	const FString CapturePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("HitboxReplayReducedTiers.hbxcap"));
+
+	// ==========================================
+	// LIVE
+	// ==========================================
+
+	int64 LiveHits = 0;
+	uint64 LiveChecksum = 0;
+	int32 LivePassesSkipped = 0;
+	{
+		FHitboxBenchmarkWorld LiveWorld;
+		UHitboxWorldSubsystem* Subsystem = LiveWorld.GetSubsystem();
+		if (!TestNotNull(TEXT("Hitbox world subsystem"), Subsystem)) return false;
+
+		Subsystem->bTrackAttackInstances = false;
+		Subsystem->ReducedUpdateInterval = 3;
+
+		// Start the capture mid-session, after an id the replay never hands out
+		Subsystem->UnregisterParticipant(Subsystem->RegisterParticipant(LiveWorld.GetWorld()->SpawnActor<AActor>(), Asset, 0));
+		for (int32 Tick = 0; Tick < 5; ++Tick)
+		{
+			Subsystem->AdvanceSimulation(DeltaTime);
+		}
+		if (!TestTrue(TEXT("Capture started"), Subsystem->StartCapture(CapturePath))) return false;
+
+		TArray<int32> Ids;
+		for (int32 Index = 0; Index < Agents.Num(); ++Index)
+		{
+			const FHitboxBenchmarkAgent& Agent = Agents[Index];
+			const int32 Id = Subsystem->RegisterParticipant(LiveWorld.GetWorld()->SpawnActor<AActor>(), Asset, Agent.Team);
+			Subsystem->SetParticipantTransform(Id, Agent.Position, Agent.bFlipX, Agent.Scale);
+			Subsystem->SetParticipantTier(Id, Index % 2 ? EHitboxProcessingTier::Reduced : EHitboxProcessingTier::Full);
+			Ids.Add(Id);
+		}
+
+		for (int32 Tick = 0; Tick < Ticks; ++Tick)
+		{
+			for (int32 Index = 0; Index < Agents.Num(); ++Index)
+			{
+				Subsystem->SetParticipantFrame(Ids[Index], 0, FHitboxBenchmarkUtils::GetAgentFrameIndex(Agents[Index], Tick));
+			}
+
+			Subsystem->AdvanceSimulation(DeltaTime);
+
+			// Live ids are the ones written to the capture
+			for (const FHitboxHitEvent& Hit : Subsystem->GetTickHits())
+			{
+				LiveChecksum += FHitboxCaptureReplayer::HashHit(Hit, Hit.AttackerParticipantId, Hit.DefenderParticipantId);
+			}
+			LiveHits += Subsystem->GetTickHits().Num();
+			LivePassesSkipped += Subsystem->GetLODStats().AttackerPassesSkipped;
+		}
+		Subsystem->StopCapture();
+	}
+
+	// A session that never collides, or never throttles, wouldn't check anything
+	TestTrue(TEXT("Live session has hits"), LiveHits > 0);
+	TestTrue(TEXT("Live session skipped attacker passes"), LivePassesSkipped > 0);
+
+	// ==========================================
+	// REPLAY
+	// ==========================================
+
+	FHitboxCapture Capture;
+	if (!TestTrue(TEXT("Capture loaded"), Capture.Load(CapturePath))) return false;
+
+	FHitboxBenchmarkWorld ReplayWorld;
+	UHitboxWorldSubsystem* Subsystem = ReplayWorld.GetSubsystem();
+	if (!TestNotNull(TEXT("Hitbox world subsystem"), Subsystem)) return false;
+
+	FHitboxCaptureReplayer Replayer;
+	Replayer.Init(*Subsystem, Capture, { Asset }, Agents.Num());
+
+	for (int32 Pass = 0; Pass < 2; ++Pass)
+	{
+		int64 Hits = 0;
+		uint64 Checksum = 0;
+		Replayer.Rewind();
+		Replayer.Replay(Hits, Checksum);
+
+		TestEqual(*FString::Printf(TEXT("Pass %d hits"), Pass), Hits, LiveHits);
+		TestEqual(*FString::Printf(TEXT("Pass %d checksum"), Pass), Checksum, LiveChecksum);
+	}
+
+	IFileManager::Get().Delete(*CapturePath);
+	return true;
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include "HitboxBenchmarkUtils.h"
+#include "HitboxBlueprintLibrary.h"
+#include "HitboxDataAsset.h"
+#include "HitboxWorldSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HitboxScenarioTests
+{
+	/** Ticks per scenario; frames advance every tick, so each agent goes through all of its frames twice */
+	static constexpr int32 Ticks = 8;
+
+	/**
+	 * Run a benchmark scenario through world subsystem hit processing and check every tick's hit count
+	 * against CheckHitboxCollision over all cross-team pairs
+	 */
+	static bool RunScenario(FAutomationTestBase& Test, const TCHAR* Name)
+	{
+		const FHitboxBenchmarkScenario* Scenario = FHitboxBenchmarkUtils::FindScenario(Name);
+		if (!Test.TestNotNull(TEXT("Scenario"), Scenario)) return false;
+
+		FRandomStream Random(0);
+		UHitboxDataAsset* Asset = FHitboxBenchmarkUtils::MakeScenarioAsset(*Scenario, Random);
+		const TArray<FHitboxBenchmarkAgent> Agents = FHitboxBenchmarkUtils::MakeScenarioAgents(*Scenario, Random);
+		const TArray<FFrameHitboxData>& Frames = Asset->Animations[0].Frames;
+
+		FHitboxBenchmarkWorld TestWorld;
+		UHitboxWorldSubsystem* Subsystem = TestWorld.GetSubsystem();
+		if (!Test.TestNotNull(TEXT("Hitbox world subsystem"), Subsystem)) return false;
+
+		// Count every overlap, like CheckHitboxCollision
+		Subsystem->bTrackAttackInstances = false;
+
+		TArray<int32> Ids;
+		for (const FHitboxBenchmarkAgent& Agent : Agents)
+		{
+			const int32 Id = Subsystem->RegisterParticipant(TestWorld.GetWorld()->SpawnActor<AActor>(), Asset, Agent.Team);
+			Subsystem->SetParticipantTransform(Id, Agent.Position, Agent.bFlipX, Agent.Scale);
+			Ids.Add(Id);
+		}
+
+		TArray<FHitboxCollisionResult> Hits;
+		int64 TotalHits = 0;
+		for (int32 Tick = 0; Tick < Ticks; ++Tick)
+		{
+			for (int32 Index = 0; Index < Agents.Num(); ++Index)
+			{
+				Subsystem->SetParticipantFrame(Ids[Index], 0, FHitboxBenchmarkUtils::GetAgentFrameIndex(Agents[Index], Tick));
+			}
+
+			int32 Expected = 0;
+			for (const FHitboxBenchmarkAgent& A : Agents)
+			{
+				for (const FHitboxBenchmarkAgent& D : Agents)
+				{
+					if (A.Team == D.Team) continue;
+
+					UHitboxBlueprintLibrary::CheckHitboxCollision(
+						Frames[FHitboxBenchmarkUtils::GetAgentFrameIndex(A, Tick)], A.Position, A.bFlipX, A.Scale,
+						Frames[FHitboxBenchmarkUtils::GetAgentFrameIndex(D, Tick)], D.Position, D.bFlipX, D.Scale, Hits);
+					Expected += Hits.Num();
+				}
+			}
+
+			Subsystem->AdvanceSimulation(1.0f / 60.0f);
+			Test.TestEqual(*FString::Printf(TEXT("%s tick %d hits"), Name, Tick), Subsystem->GetTickHits().Num(), Expected);
+			TotalHits += Expected;
+		}
+
+		// A scenario that never collides wouldn't check anything
+		Test.TestTrue(*FString::Printf(TEXT("%s has hits"), Name), TotalHits > 0);
+
+		for (const int32 Id : Ids)
+		{
+			Subsystem->UnregisterParticipant(Id);
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitboxScenario1v1Test, "Hitbox.Scenarios.1v1", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHitboxScenario1v1Test::RunTest(const FString& Parameters)
+{
+	return HitboxScenarioTests::RunScenario(*this, TEXT("1v1"));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitboxScenario4v4Test, "Hitbox.Scenarios.4v4", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHitboxScenario4v4Test::RunTest(const FString& Parameters)
+{
+	return HitboxScenarioTests::RunScenario(*this, TEXT("4v4"));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitboxScenarioHordeTest, "Hitbox.Scenarios.Horde", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHitboxScenarioHordeTest::RunTest(const FString& Parameters)
+{
+	return HitboxScenarioTests::RunScenario(*this, TEXT("Horde"));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHitboxScenarioBossTest, "Hitbox.Scenarios.Boss", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FHitboxScenarioBossTest::RunTest(const FString& Parameters)
+{
+	return HitboxScenarioTests::RunScenario(*this, TEXT("Boss"));
+}
+
+#endif